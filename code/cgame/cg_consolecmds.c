@@ -611,6 +611,7 @@ static consoleCommand_t	commands[] = {
 	{ "startOrbit", CG_StartOrbit_f },
 //	{ "camera", CG_Camera_f },
 	{ "loaddeferred", CG_LoadDeferredPlayers },
+	{ "profiledump", CG_ProfileDump_f },
         { "+acc", CG_AccDown_f },
 	{ "-acc", CG_AccUp_f },
         { "clients", CG_PrintClientNumbers }
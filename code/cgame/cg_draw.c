@@ -44,21 +44,144 @@ char teamChat2[256];
 
 #ifdef MISSIONPACK
 
+/*
+=============================================================================
+
+TEXT LAYOUT CACHE
+
+The same HUD strings are measured and drawn every frame, so the glyphs
+of a string are resolved once and kept here together with its width
+and height in font units.  Entries are keyed by the text, font and
+limit, so the same string at another scale shares the entry.  Strings
+too long for an entry take the uncached path.
+
+=============================================================================
+*/
+
+#define	TEXTCACHE_SIZE		256		// must be a power of two
+#define	TEXTCACHE_MAXLEN	96
+#define	TEXTCACHE_COLOR		256		// ops at or above this are color changes
+
+typedef struct {
+	fontInfo_t		*font;			// NULL if the entry is unused
+	int				limit;
+	unsigned int	hash;
+	char			text[TEXTCACHE_MAXLEN];
+
+	float			width;			// sum of xSkip
+	float			height;			// tallest glyph
+	int				numOps;
+	short			ops[TEXTCACHE_MAXLEN];	// glyph index, or TEXTCACHE_COLOR + color index
+} textLayout_t;
+
+static textLayout_t	cg_textCache[TEXTCACHE_SIZE];
+
+/*
+================
+CG_TextCacheClear
+
+Must be called when any of the fonts are registered again
+================
+*/
+void CG_TextCacheClear( void ) {
+	memset( cg_textCache, 0, sizeof( cg_textCache ) );
+}
+
+/*
+================
+CG_TextFont
+================
+*/
+static fontInfo_t *CG_TextFont( float scale ) {
+	if (scale <= cg_smallFont.value) {
+		return &cgDC.Assets.smallFont;
+	} else if (scale > cg_bigFont.value) {
+		return &cgDC.Assets.bigFont;
+	}
+	return &cgDC.Assets.textFont;
+}
+
+/*
+================
+CG_TextLayout
+
+Returns the cached layout of text, or NULL if it can't be cached
+================
+*/
+static textLayout_t *CG_TextLayout( const char *text, fontInfo_t *font, int limit ) {
+	textLayout_t	*tl;
+	glyphInfo_t		*glyph;
+	unsigned int	hash;
+	const char		*s;
+	int				len, count;
+
+	if ( !text ) {
+		return NULL;
+	}
+
+	// case sensitive, unlike Q_HashString
+	hash = 2166136261u;
+	for ( len = 0 ; text[len] ; len++ ) {
+		if ( len == TEXTCACHE_MAXLEN - 1 ) {
+			return NULL;
+		}
+		hash = ( hash ^ (unsigned char)text[len] ) * 16777619u;
+	}
+	hash ^= limit;
+
+	tl = &cg_textCache[hash & ( TEXTCACHE_SIZE - 1 )];
+	if ( tl->font == font && tl->hash == hash && tl->limit == limit && !strcmp( tl->text, text ) ) {
+		return tl;
+	}
+
+	// walk the string the same way the uncached code does
+	tl->font = font;
+	tl->hash = hash;
+	tl->limit = limit;
+	Q_strncpyz( tl->text, text, sizeof( tl->text ) );
+	tl->width = 0;
+	tl->height = 0;
+	tl->numOps = 0;
+
+	if (limit > 0 && len > limit) {
+		len = limit;
+	}
+	count = 0;
+	s = text;
+	while ( *s && count < len ) {
+		if ( Q_IsColorString( s ) ) {
+			tl->ops[tl->numOps++] = TEXTCACHE_COLOR + ColorIndex( *(s+1) );
+			s += 2;
+			continue;
+		}
+		glyph = &font->glyphs[(int)*s];
+		tl->ops[tl->numOps++] = (int)*s;
+		tl->width += glyph->xSkip;
+		if ( tl->height < glyph->height ) {
+			tl->height = glyph->height;
+		}
+		s++;
+		count++;
+	}
+
+	return tl;
+}
+
 int CG_Text_Width(const char *text, float scale, int limit) {
   int count,len;
 	float out;
 	glyphInfo_t *glyph;
 	float useScale;
+	textLayout_t *tl;
 // FIXME: see ui_main.c, same problem
 //	const unsigned char *s = text;
 	const char *s = text;
-	fontInfo_t *font = &cgDC.Assets.textFont;
-	if (scale <= cg_smallFont.value) {
-		font = &cgDC.Assets.smallFont;
-	} else if (scale > cg_bigFont.value) {
-		font = &cgDC.Assets.bigFont;
-	}
+	fontInfo_t *font = CG_TextFont( scale );
 	useScale = scale * font->glyphScale;
+	tl = CG_TextLayout( text, font, limit );
+	if ( tl ) {
+		return tl->width * useScale;
+	}
   out = 0;
   if (text) {
     len = strlen(text);
@@ -86,16 +209,16 @@ int CG_Text_Height(const char *text, float scale, int limit) {
 	float max;
 	glyphInfo_t *glyph;
 	float useScale;
+	textLayout_t *tl;
 // TTimo: FIXME
 //	const unsigned char *s = text;
 	const char *s = text;
-	fontInfo_t *font = &cgDC.Assets.textFont;
-	if (scale <= cg_smallFont.value) {
-		font = &cgDC.Assets.smallFont;
-	} else if (scale > cg_bigFont.value) {
-		font = &cgDC.Assets.bigFont;
-	}
+	fontInfo_t *font = CG_TextFont( scale );
 	useScale = scale * font->glyphScale;
+	tl = CG_TextLayout( text, font, limit );
+	if ( tl ) {
+		return tl->height * useScale;
+	}
   max = 0;
   if (text) {
     len = strlen(text);
@@ -128,17 +251,48 @@ void CG_Text_PaintChar(float x, float y, float width, float height, float scale,
   trap_R_DrawStretchPic( x, y, w, h, s, t, s2, t2, hShader );
 }
 
+/*
+================
+CG_Text_PaintGlyph
+================
+*/
+static void CG_Text_PaintGlyph( float x, float y, float useScale, glyphInfo_t *glyph, vec4_t color, int style ) {
+	float yadj = useScale * glyph->top;
+
+	if (style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE) {
+		int ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
+		colorBlack[3] = color[3];
+		trap_R_SetColor( colorBlack );
+		CG_Text_PaintChar(x + ofs, y - yadj + ofs,
+											glyph->imageWidth,
+											glyph->imageHeight,
+											useScale,
+											glyph->s,
+											glyph->t,
+											glyph->s2,
+											glyph->t2,
+											glyph->glyph);
+		colorBlack[3] = 1.0;
+		trap_R_SetColor( color );
+	}
+	CG_Text_PaintChar(x, y - yadj,
+										glyph->imageWidth,
+										glyph->imageHeight,
+										useScale,
+										glyph->s,
+										glyph->t,
+										glyph->s2,
+										glyph->t2,
+										glyph->glyph);
+}
+
 void CG_Text_Paint(float x, float y, float scale, vec4_t color, const char *text, float adjust, int limit, int style) {
-  int len, count;
+  int len, count, i;
 	vec4_t newColor;
 	glyphInfo_t *glyph;
 	float useScale;
-	fontInfo_t *font = &cgDC.Assets.textFont;
-	if (scale <= cg_smallFont.value) {
-		font = &cgDC.Assets.smallFont;
-	} else if (scale > cg_bigFont.value) {
-		font = &cgDC.Assets.bigFont;
-	}
+	textLayout_t *tl;
+	fontInfo_t *font = CG_TextFont( scale );
 	useScale = scale * font->glyphScale;
   if (text) {
 // TTimo: FIXME
@@ -146,6 +300,24 @@ void CG_Text_Paint(float x, float y, float scale, vec4_t color, const char *text
 		const char *s = text;
 		trap_R_SetColor( color );
 		memcpy(&newColor[0], &color[0], sizeof(vec4_t));
+
+		tl = CG_TextLayout( text, font, limit );
+		if ( tl ) {
+			for ( i = 0 ; i < tl->numOps ; i++ ) {
+				if ( tl->ops[i] >= TEXTCACHE_COLOR ) {
+					memcpy( newColor, g_color_table[tl->ops[i] - TEXTCACHE_COLOR], sizeof( newColor ) );
+					newColor[3] = color[3];
+					trap_R_SetColor( newColor );
+					continue;
+				}
+				glyph = &font->glyphs[tl->ops[i]];
+				CG_Text_PaintGlyph( x, y, useScale, glyph, newColor, style );
+				x += (glyph->xSkip * useScale) + adjust;
+			}
+			trap_R_SetColor( NULL );
+			return;
+		}
+
     len = strlen(text);
 		if (limit > 0 && len > limit) {
 			len = limit;
@@ -162,32 +334,7 @@ void CG_Text_Paint(float x, float y, float scale, vec4_t color, const char *text
 				s += 2;
 				continue;
 			} else {
-				float yadj = useScale * glyph->top;
-				if (style == ITEM_TEXTSTYLE_SHADOWED || style == ITEM_TEXTSTYLE_SHADOWEDMORE) {
-					int ofs = style == ITEM_TEXTSTYLE_SHADOWED ? 1 : 2;
-					colorBlack[3] = newColor[3];
-					trap_R_SetColor( colorBlack );
-					CG_Text_PaintChar(x + ofs, y - yadj + ofs, 
-														glyph->imageWidth,
-														glyph->imageHeight,
-														useScale, 
-														glyph->s,
-														glyph->t,
-														glyph->s2,
-														glyph->t2,
-														glyph->glyph);
-					colorBlack[3] = 1.0;
-					trap_R_SetColor( newColor );
-				}
-				CG_Text_PaintChar(x, y - yadj, 
-													glyph->imageWidth,
-													glyph->imageHeight,
-													useScale, 
-													glyph->s,
-													glyph->t,
-													glyph->s2,
-													glyph->t2,
-													glyph->glyph);
+				CG_Text_PaintGlyph( x, y, useScale, glyph, newColor, style );
 				// CG_DrawPic(x, y - yadj, scale * cgDC.Assets.textFont.glyphs[text[i]].imageWidth, scale * cgDC.Assets.textFont.glyphs[text[i]].imageHeight, cgDC.Assets.textFont.glyphs[text[i]].glyph);
 				x += (glyph->xSkip * useScale) + adjust;
 				s++;
@@ -3325,6 +3472,7 @@ static void CG_Draw2D(stereoFrame_t stereoFrame)
 	if (cgs.orderPending && cg.time > cgs.orderTime) {
 		CG_CheckOrderPending();
 	}
+	Display_UpdateCvarWatches();
 #endif
 	// if we are taking a levelshot for the menu, don't draw anything
 	if ( cg.levelShot ) {
@@ -3465,10 +3613,17 @@ void CG_DrawActive( stereoFrame_t stereoView ) {
 		CG_DrawCrosshair3D();
 
 	// draw 3D view
+	CG_ProfilePhase( PROF_RENDERSCENE );
 	trap_R_RenderScene( &cg.refdef );
 
 	// draw status bar and other floating elements
+	CG_ProfilePhase( PROF_DRAW2D );
  	CG_Draw2D(stereoView);
+	CG_ProfilePhase( PROF_OTHER );
+
+	if ( cg_profile.integer ) {
+		CG_DrawProfile();
+	}
 }
 
 
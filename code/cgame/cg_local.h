@@ -399,6 +399,8 @@ typedef struct {
 	int		isDead;
 	vec3_t			eyepos;		// leilei - eye positions loaded from anim cfg
 	int		onepiece;		// leilei - g_enableFS meshes
+
+	int				modelCache;		// 1 + client model cache slot we hold, 0 if borrowed
 } clientInfo_t;
 
 
@@ -715,6 +717,12 @@ typedef struct {
 	float		bobfraccos;
 	float		bobfracsin2;
 
+	// player effect level of detail, see CG_UpdatePlayerLOD
+	float		playerLODProjection;	// pixels covered by one unit at distance one
+	float		playerLODBias;			// grows while the scene is over budget
+	int			sceneEntityBase;		// cg_profileCounters at the start of the frame
+	int			scenePolyBase;
+
 // loadingscreen
 #ifdef SCRIPTHUD
 	float         mediaFraction;
@@ -1340,6 +1348,7 @@ extern	vmCvar_t		cg_synchronousClients;
 extern	vmCvar_t		cg_teamChatTime;
 extern	vmCvar_t		cg_teamChatHeight;
 extern	vmCvar_t		cg_stats;
+extern	vmCvar_t		cg_profile;
 extern	vmCvar_t 		cg_forceModel;
 extern	vmCvar_t 		cg_buildScript;
 extern	vmCvar_t		cg_paused;
@@ -1405,6 +1414,13 @@ extern  vmCvar_t		cg_recordSPDemoName;
 extern	vmCvar_t		cg_obeliskRespawnDelay;
 extern	vmCvar_t		cg_enableDust;
 extern	vmCvar_t		cg_enableBreath;
+extern	vmCvar_t		cg_playerLOD;
+extern	vmCvar_t		cg_playerLODScale;
+extern	vmCvar_t		cg_entityBudget;
+extern	vmCvar_t		cg_polyBudget;
+extern	vmCvar_t		cg_playerLoadBudget;
+extern	vmCvar_t		cg_stringPoolSize;
+extern	vmCvar_t		cg_paintCache;
 
 extern	vmCvar_t		cg_enableQ;		// leilei
 extern	vmCvar_t		cg_enableFS;		// leilei
@@ -1575,9 +1591,11 @@ void CG_DrawActive( stereoFrame_t stereoView );
 void CG_DrawFlagModel( float x, float y, float w, float h, int team, qboolean force2D );
 void CG_DrawTeamBackground( int x, int y, int w, int h, float alpha, int team );
 void CG_OwnerDraw(float x, float y, float w, float h, float text_x, float text_y, int ownerDraw, int ownerDrawFlags, int align, float special, float scale, vec4_t color, qhandle_t shader, int textStyle);
+qboolean CG_OwnerDrawDeps(int ownerDraw, int *key, const char **cvar);
 void CG_Text_Paint(float x, float y, float scale, vec4_t color, const char *text, float adjust, int limit, int style);
 int CG_Text_Width(const char *text, float scale, int limit);
 int CG_Text_Height(const char *text, float scale, int limit);
+void CG_TextCacheClear( void );
 void CG_SelectPrevPlayer( void );
 void CG_SelectNextPlayer( void );
 float CG_GetValue(int ownerDraw);
@@ -1615,6 +1633,7 @@ void CG_ResetPlayerEntity( centity_t *cent );
 void CG_AddRefEntityWithPowerups( refEntity_t *ent, entityState_t *state, int team, qboolean isMissile );
 void CG_NewClientInfo( int clientNum );
 sfxHandle_t	CG_CustomSound( int clientNum, const char *soundName );
+void CG_UpdatePlayerLOD( void );
 
 //
 // cg_predict.c
@@ -1625,6 +1644,7 @@ void CG_Trace( trace_t *result, const vec3_t start, const vec3_t mins, const vec
 					 int skipNumber, int mask );
 void CG_PredictPlayerState( void );
 void CG_LoadDeferredPlayers( void );
+void CG_RunPlayerLoader( void );
 
 
 //
@@ -1810,6 +1830,41 @@ void CG_Respawn( void );
 void CG_TransitionPlayerState( playerState_t *ps, playerState_t *ops );
 void CG_CheckChangedPredictableEvents( playerState_t *ps );
 
+//
+// cg_profile.c
+//
+typedef enum {
+	PROF_OTHER,
+	PROF_SNAPSHOTS,
+	PROF_PREDICT,
+	PROF_CALCVIEW,
+	PROF_PACKETENTITIES,
+	PROF_MARKS,
+	PROF_LOCALENTITIES,
+	PROF_VIEWWEAPON,
+	PROF_SOUNDS,
+	PROF_RENDERSCENE,
+	PROF_DRAW2D,
+
+	PROF_NUM_PHASES
+} profPhase_t;
+
+typedef enum {
+	PROFC_REFENTITIES,
+	PROFC_POLYS,
+	PROFC_TRACES,
+
+	PROFC_NUM_COUNTERS
+} profCounter_t;
+
+extern	int		cg_profileCounters[PROFC_NUM_COUNTERS];
+
+void CG_ProfileFrameBegin( void );
+void CG_ProfilePhase( profPhase_t phase );
+void CG_ProfileFrameEnd( void );
+void CG_DrawProfile( void );
+void CG_ProfileDump_f( void );
+
 
 //===============================================
 
@@ -1878,6 +1933,13 @@ void		trap_CM_TransformedBoxTrace( trace_t *results, const vec3_t start, const v
 					  clipHandle_t model, int brushmask,
 					  const vec3_t origin, const vec3_t angles );
 
+// count traces for cg_profile, this has to happen here rather than in
+// cg_syscalls.c so it also works for qvms
+#define trap_CM_BoxTrace(r,s,e,mi,ma,m,b) \
+	( cg_profileCounters[PROFC_TRACES]++, trap_CM_BoxTrace(r,s,e,mi,ma,m,b) )
+#define trap_CM_TransformedBoxTrace(r,s,e,mi,ma,m,b,o,a) \
+	( cg_profileCounters[PROFC_TRACES]++, trap_CM_TransformedBoxTrace(r,s,e,mi,ma,m,b,o,a) )
+
 // Returns the projection of a polygon onto the solid brushes in the world
 int			trap_CM_MarkFragments( int numPoints, const vec3_t *points, 
 			const vec3_t projection,
@@ -1922,12 +1984,32 @@ void		trap_R_AddRefEntityToScene( const refEntity_t *re );
 // significant construction
 void		trap_R_AddPolyToScene( qhandle_t hShader , int numVerts, const polyVert_t *verts );
 void		trap_R_AddPolysToScene( qhandle_t hShader , int numVerts, const polyVert_t *verts, int numPolys );
+
+// count scene submissions for cg_profile
+#define trap_R_AddRefEntityToScene(re) \
+	( cg_profileCounters[PROFC_REFENTITIES]++, trap_R_AddRefEntityToScene(re) )
+#define trap_R_AddPolyToScene(sh,nv,v) \
+	( cg_profileCounters[PROFC_POLYS]++, trap_R_AddPolyToScene(sh,nv,v) )
+#define trap_R_AddPolysToScene(sh,nv,v,n) \
+	( cg_profileCounters[PROFC_POLYS] += (n), trap_R_AddPolysToScene(sh,nv,v,n) )
 void		trap_R_AddLightToScene( const vec3_t org, float intensity, float r, float g, float b );
 int			trap_R_LightForPoint( vec3_t point, vec3_t ambientLight, vec3_t directedLight, vec3_t lightDir );
 void		trap_R_RenderScene( const refdef_t *fd );
 void		trap_R_SetColor( const float *rgba );	// NULL = 1,1,1,1
 void		trap_R_DrawStretchPic( float x, float y, float w, float h, 
 			float s1, float t1, float s2, float t2, qhandle_t hShader );
+#ifdef MISSIONPACK
+// feed the menu paint cache in ui_shared.c, see ui_local.h
+extern qboolean	paintRecording;
+void		Paint_TrackColor( const float *rgba );
+void		Paint_RecordStretchPic( float x, float y, float w, float h,
+			float s1, float t1, float s2, float t2, qhandle_t hShader );
+#define trap_R_SetColor(rgba) \
+	( Paint_TrackColor(rgba), trap_R_SetColor(rgba) )
+#define trap_R_DrawStretchPic(x,y,w,h,s1,t1,s2,t2,sh) \
+	( ( paintRecording ? Paint_RecordStretchPic(x,y,w,h,s1,t1,s2,t2,sh) : (void)0 ), \
+	trap_R_DrawStretchPic(x,y,w,h,s1,t1,s2,t2,sh) )
+#endif
 void		trap_R_ModelBounds( clipHandle_t model, vec3_t mins, vec3_t maxs );
 int			trap_R_LerpTag( orientation_t *tag, clipHandle_t mod, int startFrame, int endFrame, 
 					   float frac, const char *tagName );
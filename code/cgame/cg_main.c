@@ -156,6 +156,7 @@ vmCvar_t	cg_synchronousClients;
 vmCvar_t 	cg_teamChatTime;
 vmCvar_t 	cg_teamChatHeight;
 vmCvar_t 	cg_stats;
+vmCvar_t	cg_profile;
 vmCvar_t 	cg_buildScript;
 vmCvar_t 	cg_forceModel;
 vmCvar_t	cg_paused;
@@ -229,6 +230,13 @@ vmCvar_t	cg_recordSPDemoName;
 vmCvar_t	cg_obeliskRespawnDelay;
 vmCvar_t	cg_enableDust;
 vmCvar_t	cg_enableBreath;
+vmCvar_t	cg_playerLOD;
+vmCvar_t	cg_playerLODScale;
+vmCvar_t	cg_entityBudget;
+vmCvar_t	cg_polyBudget;
+vmCvar_t	cg_playerLoadBudget;
+vmCvar_t	cg_stringPoolSize;
+vmCvar_t	cg_paintCache;
 vmCvar_t	cg_enableFS;
 vmCvar_t	cg_enableQ;
 
@@ -372,6 +380,7 @@ static cvarTable_t cvarTable[] = { // bk001129
 	{ &cg_drawTeamOverlay, "cg_drawTeamOverlay", "0", CVAR_ARCHIVE },
 	{ &cg_teamOverlayUserinfo, "teamoverlay", "0", CVAR_ROM | CVAR_USERINFO },
 	{ &cg_stats, "cg_stats", "0", 0 },
+	{ &cg_profile, "cg_profile", "0", 0 },
 	{ &cg_drawFriend, "cg_drawFriend", "1", CVAR_ARCHIVE },
 	{ &cg_teamChatsOnly, "cg_teamChatsOnly", "0", CVAR_ARCHIVE },
 	{ &cg_noVoiceChats, "cg_noVoiceChats", "0", CVAR_ARCHIVE },
@@ -405,6 +414,13 @@ static cvarTable_t cvarTable[] = { // bk001129
 	{ &cg_enableQ, "g_enableQ", "0", CVAR_SERVERINFO},
 	{ &cg_enableDust, "g_enableDust", "0", CVAR_SERVERINFO},
 	{ &cg_enableBreath, "g_enableBreath", "0", CVAR_SERVERINFO},
+	{ &cg_playerLOD, "cg_playerLOD", "1", CVAR_ARCHIVE},
+	{ &cg_playerLODScale, "cg_playerLODScale", "1", CVAR_ARCHIVE},
+	{ &cg_entityBudget, "cg_entityBudget", "768", CVAR_ARCHIVE},
+	{ &cg_polyBudget, "cg_polyBudget", "512", CVAR_ARCHIVE},
+	{ &cg_playerLoadBudget, "cg_playerLoadBudget", "2", CVAR_ARCHIVE},
+	{ &cg_stringPoolSize, "cg_stringPoolSize", "0", CVAR_ARCHIVE},
+	{ &cg_paintCache, "cg_paintCache", "1", CVAR_ARCHIVE},
 	{ &cg_obeliskRespawnDelay, "g_obeliskRespawnDelay", "10", CVAR_SERVERINFO},
 
 	{ &cg_cameraOrbit, "cg_cameraOrbit", "0", CVAR_CHEAT},
@@ -1569,6 +1585,7 @@ qboolean CG_Asset_Parse(int handle) {
 				return qfalse;
 			}
 			cgDC.registerFont(tempStr, pointSize, &cgDC.Assets.textFont);
+			CG_TextCacheClear();
 			continue;
 		}
 
@@ -1579,6 +1596,7 @@ qboolean CG_Asset_Parse(int handle) {
 				return qfalse;
 			}
 			cgDC.registerFont(tempStr, pointSize, &cgDC.Assets.smallFont);
+			CG_TextCacheClear();
 			continue;
 		}
 
@@ -1589,6 +1607,7 @@ qboolean CG_Asset_Parse(int handle) {
 				return qfalse;
 			}
 			cgDC.registerFont(tempStr, pointSize, &cgDC.Assets.bigFont);
+			CG_TextCacheClear();
 			continue;
 		}
 
@@ -2256,6 +2275,11 @@ static void CG_RunCinematicFrame(int handle) {
   trap_CIN_RunCinematic(handle);
 }
 
+// goes through the paint cache wrapper, unlike &trap_R_SetColor
+static void CG_SetColor(const float *rgba) {
+	trap_R_SetColor(rgba);
+}
+
 /*
 =================
 CG_LoadHudMenu();
@@ -2267,7 +2291,7 @@ void CG_LoadHudMenu( void ) {
 	const char *hudSet;
 
 	cgDC.registerShaderNoMip = &trap_R_RegisterShaderNoMip;
-	cgDC.setColor = &trap_R_SetColor;
+	cgDC.setColor = &CG_SetColor;
 	cgDC.drawHandlePic = &CG_DrawPic;
 	cgDC.drawStretchPic = &trap_R_DrawStretchPic;
 	cgDC.drawText = &CG_Text_Paint;
@@ -2286,6 +2310,7 @@ void CG_LoadHudMenu( void ) {
 	cgDC.ownerDrawItem = &CG_OwnerDraw;
 	cgDC.getValue = &CG_GetValue;
 	cgDC.ownerDrawVisible = &CG_OwnerDrawVisible;
+	cgDC.ownerDrawDeps = &CG_OwnerDrawDeps;
 	cgDC.runScript = &CG_RunMenuScript;
 	cgDC.getTeamColor = &CG_GetTeamColor;
 	cgDC.setCVar = trap_Cvar_Set;
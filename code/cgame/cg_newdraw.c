@@ -2108,6 +2108,48 @@ void CG_OwnerDraw(float x, float y, float w, float h, float text_x, float text_y
   }
 }
 
+/*
+=================
+CG_OwnerDrawDeps
+
+What an owner draw reads, for the paint cache in ui_shared.c.  Owner
+draws that are not listed here are drawn every frame.
+=================
+*/
+qboolean CG_OwnerDrawDeps(int ownerDraw, int *key, const char **cvar) {
+	*key = 0;
+	*cvar = NULL;
+
+	// nothing is drawn, and it is cheap
+	if ( cg_drawStatus.integer == 0 ) {
+		return qfalse;
+	}
+
+	switch (ownerDraw) {
+	case CG_PLAYER_SCORE:
+		*key = cg.snap->ps.persistant[PERS_SCORE];
+		break;
+	case CG_RED_SCORE:
+		*key = cgs.scores1;
+		break;
+	case CG_BLUE_SCORE:
+		*key = cgs.scores2;
+		break;
+	case CG_RED_NAME:
+		*cvar = "g_redteam";
+		break;
+	case CG_BLUE_NAME:
+		*cvar = "g_blueteam";
+		break;
+	case CG_GAME_TYPE:
+		*key = cgs.gametype;
+		break;
+	default:
+		return qfalse;
+	}
+	return qtrue;
+}
+
 
 void CG_MouseEvent(int x, int y) {
 	int n;
@@ -734,22 +734,13 @@ static qboolean	CG_RegisterClientSkin( clientInfo_t *ci, const char *teamName, c
 
 /*
 ==========================
-CG_RegisterClientModelname
+CG_RegisterClientBodyModels
 ==========================
 */
-static qboolean CG_RegisterClientModelname( clientInfo_t *ci, const char *modelName, const char *skinName, const char *headModelName, const char *headSkinName, const char *teamName ) {
+static qboolean CG_RegisterClientBodyModels( clientInfo_t *ci, const char *modelName ) {
 	char	filename[MAX_QPATH*2];
-	const char		*headName;
-	char newTeamName[MAX_QPATH*2];
 	int FSloaded = 0;
 
-	if ( headModelName[0] == '\0' ) {
-		headName = modelName;
-	}
-	else {
-		headName = headModelName;
-	}
-
 	if (cg_enableFS.integer){
 
 		Com_sprintf( filename, sizeof( filename ), "models/players/%s/lowerfs.mdr", modelName );
@@ -819,6 +810,17 @@ static qboolean CG_RegisterClientModelname( clientInfo_t *ci, const char *modelN
 
 	}		// enableFS
 
+	return qtrue;
+}
+
+/*
+==========================
+CG_RegisterClientHeadModel
+==========================
+*/
+static qboolean CG_RegisterClientHeadModel( clientInfo_t *ci, const char *headModelName, const char *headName ) {
+	char	filename[MAX_QPATH*2];
+
 	if( headName[0] == '*' ) {
 		Com_sprintf( filename, sizeof( filename ), "models/players/heads/%s/%s.mdr", &headModelName[1], &headModelName[1] );
 	}
@@ -850,7 +852,18 @@ static qboolean CG_RegisterClientModelname( clientInfo_t *ci, const char *modelN
 	}
 	}
 
-	// if any skins failed to load, return failure
+	return qtrue;
+}
+
+/*
+==========================
+CG_RegisterClientSkins
+==========================
+*/
+static qboolean CG_RegisterClientSkins( clientInfo_t *ci, const char *modelName, const char *skinName, const char *headName, const char *headSkinName, const char *teamName ) {
+	char newTeamName[MAX_QPATH*2];
+
+	// if any skins failed to load, try the default team skin
 	if ( !CG_RegisterClientSkin( ci, teamName, modelName, skinName, headName, headSkinName ) ) {
 		if ( teamName && *teamName) {
 			Com_Printf( "Failed to load skin file: %s : %s : %s, %s : %s\n", teamName, modelName, skinName, headName, headSkinName );
@@ -870,6 +883,17 @@ static qboolean CG_RegisterClientModelname( clientInfo_t *ci, const char *modelN
 		}
 	}
 
+	return qtrue;
+}
+
+/*
+==========================
+CG_LoadClientAnimations
+==========================
+*/
+static qboolean CG_LoadClientAnimations( clientInfo_t *ci, const char *modelName ) {
+	char	filename[MAX_QPATH*2];
+
 	// load the animations
 	Com_sprintf( filename, sizeof( filename ), "models/players/%s/animation.cfg", modelName );
 	if ( !CG_ParseAnimationFile( filename, ci ) ) {
@@ -888,6 +912,17 @@ static qboolean CG_RegisterClientModelname( clientInfo_t *ci, const char *modelN
 	
 
 
+	return qtrue;
+}
+
+/*
+==========================
+CG_RegisterClientIcon
+==========================
+*/
+static qboolean CG_RegisterClientIcon( clientInfo_t *ci, const char *headName, const char *headSkinName, const char *teamName ) {
+	char	filename[MAX_QPATH*2];
+
 	if ( CG_FindClientHeadFile( filename, sizeof(filename), ci, teamName, headName, headSkinName, "icon", "skin" ) ) {
 		ci->modelIcon = trap_R_RegisterShaderNoMip( filename );
 	}
@@ -902,6 +937,47 @@ static qboolean CG_RegisterClientModelname( clientInfo_t *ci, const char *modelN
 	return qtrue;
 }
 
+/*
+==========================
+CG_ClientHeadName
+==========================
+*/
+static const char *CG_ClientHeadName( const char *modelName, const char *headModelName ) {
+	if ( headModelName[0] == '\0' ) {
+		return modelName;
+	}
+	return headModelName;
+}
+
+/*
+==========================
+CG_RegisterClientModelname
+
+The individual steps are also run one at a time by the incremental
+player loader, see CG_RunPlayerLoader.
+==========================
+*/
+static qboolean CG_RegisterClientModelname( clientInfo_t *ci, const char *modelName, const char *skinName, const char *headModelName, const char *headSkinName, const char *teamName ) {
+	const char		*headName;
+
+	headName = CG_ClientHeadName( modelName, headModelName );
+
+	if ( !CG_RegisterClientBodyModels( ci, modelName ) ) {
+		return qfalse;
+	}
+	if ( !CG_RegisterClientHeadModel( ci, headModelName, headName ) ) {
+		return qfalse;
+	}
+	// if any skins failed to load, return failure
+	if ( !CG_RegisterClientSkins( ci, modelName, skinName, headName, headSkinName, teamName ) ) {
+		return qfalse;
+	}
+	if ( !CG_LoadClientAnimations( ci, modelName ) ) {
+		return qfalse;
+	}
+	return CG_RegisterClientIcon( ci, headName, headSkinName, teamName );
+}
+
 /*
 ====================
 CG_ColorFromString
@@ -930,72 +1006,216 @@ static void CG_ColorFromString( const char *v, vec3_t color ) {
 	}
 }
 
+/*
+======================
+CG_CopyClientInfoModel
+======================
+*/
+static void CG_CopyClientInfoModel( clientInfo_t *from, clientInfo_t *to ) {
+	VectorCopy( from->headOffset, to->headOffset );
+	VectorCopy( from->eyepos, to->eyepos );
+	to->footsteps = from->footsteps;
+	to->gender = from->gender;
+
+	to->legsModel = from->legsModel;
+	to->legsSkin = from->legsSkin;
+	to->torsoModel = from->torsoModel;
+	to->torsoSkin = from->torsoSkin;
+	to->headModel = from->headModel;
+	to->headSkin = from->headSkin;
+	to->modelIcon = from->modelIcon;
+
+	to->newAnims = from->newAnims;
+	to->fixedlegs = from->fixedlegs;
+	to->fixedtorso = from->fixedtorso;
+
+	memcpy( to->animations, from->animations, sizeof( to->animations ) );
+	memcpy( to->sounds, from->sounds, sizeof( to->sounds ) );
+}
+
+/*
+=============================================================================
+
+CLIENT MODEL CACHE
+
+Every set of player models that has been loaded is kept here, keyed by
+everything CG_LoadClientInfo looks at.  A new clientinfo with the same
+key just copies the handles.  Entries stay after the last player using
+them leaves, so reconnects and team switches don't load anything, and
+since the cache lives as long as the cgame module it also survives
+map_restart.  Entries nobody references are reused when it fills up.
+
+=============================================================================
+*/
+
+#define	MAX_CLIENTMODELS		64
+#define	CLIENTMODEL_HASH_SIZE	128
+#define	MAX_CLIENTMODEL_KEY		( MAX_QPATH * 4 + MAX_TEAMNAME * 2 + 16 )
+
+typedef struct {
+	char			key[MAX_CLIENTMODEL_KEY];
+	int				refCount;
+	int				hashNext;		// 1 + next entry in the bucket, 0 = end
+	clientInfo_t	info;			// only the parts CG_CopyClientInfoModel copies
+} clientModel_t;
+
+static clientModel_t	cg_clientModels[MAX_CLIENTMODELS];
+static int				cg_numClientModels;
+static int				cg_clientModelHash[CLIENTMODEL_HASH_SIZE];
+
+/*
+======================
+CG_ClientModelKey
+======================
+*/
+static void CG_ClientModelKey( clientInfo_t *ci, char *key, int size ) {
+	int		team;
+
+	// the team only picks the skin in team games
+	if ( cgs.gametype >= GT_TEAM && cgs.ffa_gt != 1 ) {
+		team = ci->team;
+	} else {
+		team = TEAM_FREE;
+	}
+
+	Com_sprintf( key, size, "%s/%s\\%s/%s\\%s\\%s\\%i", ci->modelName, ci->skinName,
+		ci->headModelName, ci->headSkinName, ci->redTeam, ci->blueTeam, team );
+}
+
+/*
+======================
+CG_FindClientModel
+
+Returns the cache slot for key or -1
+======================
+*/
+static int CG_FindClientModel( const char *key ) {
+	int		i;
+
+	for ( i = cg_clientModelHash[Q_HashString( key ) & ( CLIENTMODEL_HASH_SIZE - 1 )]; i;
+		i = cg_clientModels[i - 1].hashNext ) {
+		if ( !Q_stricmp( cg_clientModels[i - 1].key, key ) ) {
+			return i - 1;
+		}
+	}
+	return -1;
+}
+
+/*
+======================
+CG_UnlinkClientModel
+======================
+*/
+static void CG_UnlinkClientModel( int num ) {
+	int		*link;
+
+	link = &cg_clientModelHash[Q_HashString( cg_clientModels[num].key ) & ( CLIENTMODEL_HASH_SIZE - 1 )];
+	while ( *link ) {
+		if ( *link == num + 1 ) {
+			*link = cg_clientModels[num].hashNext;
+			return;
+		}
+		link = &cg_clientModels[*link - 1].hashNext;
+	}
+}
+
+/*
+======================
+CG_ReleaseClientModel
+======================
+*/
+static void CG_ReleaseClientModel( clientInfo_t *ci ) {
+	if ( ci->modelCache ) {
+		cg_clientModels[ci->modelCache - 1].refCount--;
+		ci->modelCache = 0;
+	}
+}
+
+/*
+======================
+CG_CacheClientModel
+
+Stores the models ci just loaded so other clients can share them
+======================
+*/
+static void CG_CacheClientModel( clientInfo_t *ci ) {
+	char			key[MAX_CLIENTMODEL_KEY];
+	clientModel_t	*cm;
+	int				i, hash;
+
+	CG_ReleaseClientModel( ci );
+
+	CG_ClientModelKey( ci, key, sizeof( key ) );
+	i = CG_FindClientModel( key );
+	if ( i < 0 ) {
+		if ( cg_numClientModels < MAX_CLIENTMODELS ) {
+			i = cg_numClientModels++;
+		} else {
+			// reuse a model set nobody is using right now
+			for ( i = 0 ; i < MAX_CLIENTMODELS ; i++ ) {
+				if ( cg_clientModels[i].refCount <= 0 ) {
+					break;
+				}
+			}
+			if ( i == MAX_CLIENTMODELS ) {
+				return;
+			}
+			CG_UnlinkClientModel( i );
+		}
+
+		cm = &cg_clientModels[i];
+		Q_strncpyz( cm->key, key, sizeof( cm->key ) );
+		cm->refCount = 0;
+		hash = Q_HashString( key ) & ( CLIENTMODEL_HASH_SIZE - 1 );
+		cm->hashNext = cg_clientModelHash[hash];
+		cg_clientModelHash[hash] = i + 1;
+	}
+
+	cm = &cg_clientModels[i];
+	CG_CopyClientInfoModel( ci, &cm->info );
+	cm->refCount++;
+	ci->modelCache = i + 1;
+}
+
 /*
 ===================
-CG_LoadClientInfo
+CG_ClientTeamName
 
-Load it now, taking the disk hits.
-This will usually be deferred to a safe time
+The team folder prefix used when looking up the client's skins
 ===================
 */
-static void CG_LoadClientInfo( int clientNum, clientInfo_t *ci ) {
-	const char	*dir, *fallback;
-	int			i, modelloaded;
-	const char	*s;
-	char		teamname[MAX_QPATH];
-
+static void CG_ClientTeamName( clientInfo_t *ci, char *teamname, int size ) {
 	teamname[0] = 0;
 #ifdef MISSIONPACK
 	if( cgs.gametype >= GT_TEAM && cgs.ffa_gt!=1) {
 		if( ci->team == TEAM_BLUE ) {
-			Q_strncpyz(teamname, cg_blueTeamName.string, sizeof(teamname) );
+			Q_strncpyz(teamname, cg_blueTeamName.string, size );
 		} else {
-			Q_strncpyz(teamname, cg_redTeamName.string, sizeof(teamname) );
+			Q_strncpyz(teamname, cg_redTeamName.string, size );
 		}
 	}
 	if( teamname[0] ) {
-		strcat( teamname, "/" );
+		Q_strcat( teamname, size, "/" );
 	}
 #endif
-	modelloaded = qtrue;
-	if ( !CG_RegisterClientModelname( ci, ci->modelName, ci->skinName, ci->headModelName, ci->headSkinName, teamname ) ) {
-		if ( cg_buildScript.integer ) {
-			CG_Error( "CG_RegisterClientModelname( %s, %s, %s, %s %s ) failed", ci->modelName, ci->skinName, ci->headModelName, ci->headSkinName, teamname );
-		}
+}
 
-		// fall back to default team name
-		if( cgs.gametype >= GT_TEAM && cgs.ffa_gt!=1) {
-			// keep skin name
-			if( ci->team == TEAM_BLUE ) {
-				Q_strncpyz(teamname, DEFAULT_BLUETEAM_NAME, sizeof(teamname) );
-			} else {
-				Q_strncpyz(teamname, DEFAULT_REDTEAM_NAME, sizeof(teamname) );
-			}
-			if ( !CG_RegisterClientModelname( ci, DEFAULT_TEAM_MODEL, ci->skinName, DEFAULT_TEAM_HEAD, ci->skinName, teamname ) ) {
-				CG_Error( "DEFAULT_TEAM_MODEL / skin (%s/%s) failed to register", DEFAULT_TEAM_MODEL, ci->skinName );
-			}
-		} else {
-			if ( !CG_RegisterClientModelname( ci, DEFAULT_MODEL, "default", DEFAULT_MODEL, "default", teamname ) ) {
-				CG_Error( "DEFAULT_MODEL (%s) failed to register", DEFAULT_MODEL );
-			}
-		}
-		modelloaded = qfalse;
-	}
+/*
+===================
+CG_RegisterClientSounds
 
-	ci->newAnims = qfalse;
-	if ( ci->torsoModel ) {
-		orientation_t tag;
-		// if the torso model has the "tag_flag"
-		if ( trap_R_LerpTag( &tag, ci->torsoModel, 0, 0, 1, "tag_flag" ) ) {
-			ci->newAnims = qtrue;
-		}
-	}
+Registers custom sounds first up to but not including last
+===================
+*/
+static void CG_RegisterClientSounds( clientInfo_t *ci, qboolean modelloaded, int first, int last ) {
+	const char	*dir, *fallback;
+	int			i;
+	const char	*s;
 
-	// sounds
 	dir = ci->modelName;
 	fallback = (cgs.gametype >= GT_TEAM && cgs.ffa_gt!=1) ? DEFAULT_TEAM_MODEL : DEFAULT_MODEL;
 
-	for ( i = 0 ; i < MAX_CUSTOM_SOUNDS ; i++ ) {
+	for ( i = first ; i < last && i < MAX_CUSTOM_SOUNDS ; i++ ) {
 		s = cg_customSoundNames[i];
 		if ( !s ) {
 			break;
@@ -1009,9 +1229,31 @@ static void CG_LoadClientInfo( int clientNum, clientInfo_t *ci ) {
 			ci->sounds[i] = trap_S_RegisterSound( va("sound/player/%s/%s", fallback, s + 1), qfalse );
 		}
 	}
+}
+
+/*
+===================
+CG_ClientInfoLoaded
+
+All models, skins and sounds of ci are registered
+===================
+*/
+static void CG_ClientInfoLoaded( int clientNum, clientInfo_t *ci ) {
+	int		i;
+
+	ci->newAnims = qfalse;
+	if ( ci->torsoModel ) {
+		orientation_t tag;
+		// if the torso model has the "tag_flag"
+		if ( trap_R_LerpTag( &tag, ci->torsoModel, 0, 0, 1, "tag_flag" ) ) {
+			ci->newAnims = qtrue;
+		}
+	}
 
 	ci->deferred = qfalse;
 
+	CG_CacheClientModel( ci );
+
 	// reset any existing players and bodies, because they might be in bad
 	// frames for this new model
 	for ( i = 0 ; i < MAX_GENTITIES ; i++ ) {
@@ -1023,28 +1265,48 @@ static void CG_LoadClientInfo( int clientNum, clientInfo_t *ci ) {
 }
 
 /*
-======================
-CG_CopyClientInfoModel
-======================
+===================
+CG_LoadClientInfo
+
+Load it now, taking the disk hits.
+This will usually be deferred to a safe time
+===================
 */
-static void CG_CopyClientInfoModel( clientInfo_t *from, clientInfo_t *to ) {
-	VectorCopy( from->headOffset, to->headOffset );
-	VectorCopy( from->eyepos, to->eyepos );
-	to->footsteps = from->footsteps;
-	to->gender = from->gender;
+static void CG_LoadClientInfo( int clientNum, clientInfo_t *ci ) {
+	int			modelloaded;
+	char		teamname[MAX_QPATH];
 
-	to->legsModel = from->legsModel;
-	to->legsSkin = from->legsSkin;
-	to->torsoModel = from->torsoModel;
-	to->torsoSkin = from->torsoSkin;
-	to->headModel = from->headModel;
-	to->headSkin = from->headSkin;
-	to->modelIcon = from->modelIcon;
+	CG_ClientTeamName( ci, teamname, sizeof( teamname ) );
 
-	to->newAnims = from->newAnims;
+	modelloaded = qtrue;
+	if ( !CG_RegisterClientModelname( ci, ci->modelName, ci->skinName, ci->headModelName, ci->headSkinName, teamname ) ) {
+		if ( cg_buildScript.integer ) {
+			CG_Error( "CG_RegisterClientModelname( %s, %s, %s, %s %s ) failed", ci->modelName, ci->skinName, ci->headModelName, ci->headSkinName, teamname );
+		}
 
-	memcpy( to->animations, from->animations, sizeof( to->animations ) );
-	memcpy( to->sounds, from->sounds, sizeof( to->sounds ) );
+		// fall back to default team name
+		if( cgs.gametype >= GT_TEAM && cgs.ffa_gt!=1) {
+			// keep skin name
+			if( ci->team == TEAM_BLUE ) {
+				Q_strncpyz(teamname, DEFAULT_BLUETEAM_NAME, sizeof(teamname) );
+			} else {
+				Q_strncpyz(teamname, DEFAULT_REDTEAM_NAME, sizeof(teamname) );
+			}
+			if ( !CG_RegisterClientModelname( ci, DEFAULT_TEAM_MODEL, ci->skinName, DEFAULT_TEAM_HEAD, ci->skinName, teamname ) ) {
+				CG_Error( "DEFAULT_TEAM_MODEL / skin (%s/%s) failed to register", DEFAULT_TEAM_MODEL, ci->skinName );
+			}
+		} else {
+			if ( !CG_RegisterClientModelname( ci, DEFAULT_MODEL, "default", DEFAULT_MODEL, "default", teamname ) ) {
+				CG_Error( "DEFAULT_MODEL (%s) failed to register", DEFAULT_MODEL );
+			}
+		}
+		modelloaded = qfalse;
+	}
+
+	// sounds
+	CG_RegisterClientSounds( ci, modelloaded, 0, MAX_CUSTOM_SOUNDS );
+
+	CG_ClientInfoLoaded( clientNum, ci );
 }
 
 /*
@@ -1053,36 +1315,25 @@ CG_ScanForExistingClientInfo
 ======================
 */
 static qboolean CG_ScanForExistingClientInfo( clientInfo_t *ci ) {
-	int		i;
-	clientInfo_t	*match;
-
-	for ( i = 0 ; i < cgs.maxclients ; i++ ) {
-		match = &cgs.clientinfo[ i ];
-		if ( !match->infoValid ) {
-			continue;
-		}
-		if ( match->deferred ) {
-			continue;
-		}
-		if ( !Q_stricmp( ci->modelName, match->modelName )
-			&& !Q_stricmp( ci->skinName, match->skinName )
-			&& !Q_stricmp( ci->headModelName, match->headModelName )
-			&& !Q_stricmp( ci->headSkinName, match->headSkinName ) 
-			&& !Q_stricmp( ci->blueTeam, match->blueTeam ) 
-			&& !Q_stricmp( ci->redTeam, match->redTeam )
-			&& (cgs.gametype < GT_TEAM || cgs.ffa_gt==1 || ci->team == match->team) ) {
-			// this clientinfo is identical, so use it's handles
-
-			ci->deferred = qfalse;
-
-			CG_CopyClientInfoModel( match, ci );
-
-			return qtrue;
-		}
+	char			key[MAX_CLIENTMODEL_KEY];
+	clientModel_t	*cm;
+	int				i;
+
+	CG_ClientModelKey( ci, key, sizeof( key ) );
+	i = CG_FindClientModel( key );
+	if ( i < 0 ) {
+		// nothing matches, so defer the load
+		return qfalse;
 	}
 
-	// nothing matches, so defer the load
-	return qfalse;
+	// these models are already loaded, so use their handles
+	cm = &cg_clientModels[i];
+	ci->deferred = qfalse;
+	CG_CopyClientInfoModel( &cm->info, ci );
+	cm->refCount++;
+	ci->modelCache = i + 1;
+
+	return qtrue;
 }
 
 /*
@@ -1167,6 +1418,7 @@ void CG_NewClientInfo( int clientNum ) {
 	clientInfo_t *ci;
 	clientInfo_t newInfo;
 	const char	*configstring;
+	infoView_t	info;
 	const char	*v;
 	char		*slash;
 
@@ -1174,6 +1426,7 @@ void CG_NewClientInfo( int clientNum ) {
 
 	configstring = CG_ConfigString( clientNum + CS_PLAYERS );
 	if ( !configstring[0] ) {
+		CG_ReleaseClientModel( ci );
 		memset( ci, 0, sizeof( *ci ) );
 		return;		// player just left
 	}
@@ -1181,54 +1434,55 @@ void CG_NewClientInfo( int clientNum ) {
 	// build into a temp buffer so the defer checks can use
 	// the old value
 	memset( &newInfo, 0, sizeof( newInfo ) );
+	Info_Parse( &info, configstring );
 
 	// isolate the player's name
-	v = Info_ValueForKey(configstring, "n");
+	v = Info_ViewValue( &info, "n");
 	Q_strncpyz( newInfo.name, v, sizeof( newInfo.name ) );
 
 	// colors
-	v = Info_ValueForKey( configstring, "c1" );
+	v = Info_ViewValue( &info, "c1" );
 	CG_ColorFromString( v, newInfo.color1 );
 
-	v = Info_ValueForKey( configstring, "c2" );
+	v = Info_ViewValue( &info, "c2" );
 	CG_ColorFromString( v, newInfo.color2 );
 
 	// bot skill
-	v = Info_ValueForKey( configstring, "skill" );
+	v = Info_ViewValue( &info, "skill" );
 	newInfo.botSkill = atoi( v );
 
 	// handicap
-	v = Info_ValueForKey( configstring, "hc" );
+	v = Info_ViewValue( &info, "hc" );
 	newInfo.handicap = atoi( v );
 
 	// wins
-	v = Info_ValueForKey( configstring, "w" );
+	v = Info_ViewValue( &info, "w" );
 	newInfo.wins = atoi( v );
 
 	// losses
-	v = Info_ValueForKey( configstring, "l" );
+	v = Info_ViewValue( &info, "l" );
 	newInfo.losses = atoi( v );
 
 	// team
-	v = Info_ValueForKey( configstring, "t" );
+	v = Info_ViewValue( &info, "t" );
 	newInfo.team = atoi( v );
 
 	// team task
-	v = Info_ValueForKey( configstring, "tt" );
+	v = Info_ViewValue( &info, "tt" );
 	newInfo.teamTask = atoi(v);
 
 	// team leader
-	v = Info_ValueForKey( configstring, "tl" );
+	v = Info_ViewValue( &info, "tl" );
 	newInfo.teamLeader = atoi(v);
 
-	v = Info_ValueForKey( configstring, "g_redteam" );
+	v = Info_ViewValue( &info, "g_redteam" );
 	Q_strncpyz(newInfo.redTeam, v, MAX_TEAMNAME);
 
-	v = Info_ValueForKey( configstring, "g_blueteam" );
+	v = Info_ViewValue( &info, "g_blueteam" );
 	Q_strncpyz(newInfo.blueTeam, v, MAX_TEAMNAME);
 
 	// model
-	v = Info_ValueForKey( configstring, "model" );
+	v = Info_ViewValue( &info, "model" );
 	if ( cg_forceModel.integer ) {
 		// forcemodel makes everyone use a single model
 		// to prevent load hitches
@@ -1272,7 +1526,7 @@ void CG_NewClientInfo( int clientNum ) {
 	}
 
 	// head model
-	v = Info_ValueForKey( configstring, "hmodel" );
+	v = Info_ViewValue( &info, "hmodel" );
 	if ( cg_forceModel.integer ) {
 		// forcemodel makes everyone use a single model
 		// to prevent load hitches
@@ -1323,7 +1577,7 @@ void CG_NewClientInfo( int clientNum ) {
 		forceDefer = trap_MemoryRemaining() < 4000000;
 
 		// if we are defering loads, just have it pick the first valid
-		if ( forceDefer || (cg_deferPlayers.integer && !cg_buildScript.integer && !cg.loading ) ) {
+		if ( forceDefer || ( ( cg_deferPlayers.integer || cg_playerLoadBudget.integer > 0 ) && !cg_buildScript.integer && !cg.loading ) ) {
 			// keep whatever they had if it won't violate team skins
 			CG_SetDeferredClientInfo( clientNum, &newInfo );
 			// if we are low on memory, leave them with this model
@@ -1337,6 +1591,7 @@ void CG_NewClientInfo( int clientNum ) {
 	}
 
 	// replace whatever was there with the new one
+	CG_ReleaseClientModel( ci );
 	newInfo.infoValid = qtrue;
 	*ci = newInfo;
 }
@@ -1374,6 +1629,218 @@ void CG_LoadDeferredPlayers( void ) {
 /*
 =============================================================================
 
+INCREMENTAL PLAYER LOADING
+
+With cg_playerLoadBudget set, players whose models aren't loaded yet are
+deferred as with cg_deferPlayers, but instead of waiting for the
+scoreboard their models are loaded here a step at a time.  Each frame
+runs as many steps as fit in the budget, and the player keeps the
+borrowed models until the whole set is registered.  If any step fails
+the player is handed to CG_LoadClientInfo, which knows all the fallbacks
+to the default models.
+
+=============================================================================
+*/
+
+typedef enum {
+	PLOAD_BODY,
+	PLOAD_HEAD,
+	PLOAD_SKINS,
+	PLOAD_ANIMATIONS,
+	PLOAD_ICON,
+	PLOAD_SOUNDS,
+	PLOAD_DONE
+} playerLoadStep_t;
+
+#define	PLOAD_SOUNDS_PER_STEP	4
+
+typedef struct {
+	qboolean		active;
+	int				clientNum;
+	int				step;
+	int				sound;			// next custom sound to register
+	char			teamname[MAX_QPATH];
+	char			key[MAX_CLIENTMODEL_KEY];
+	clientInfo_t	info;			// the models are registered in here
+} playerLoad_t;
+
+static playerLoad_t	cg_playerLoad;
+
+/*
+======================
+CG_StartPlayerLoad
+
+Picks the next deferred player, returns qfalse if there is none
+======================
+*/
+static qboolean CG_StartPlayerLoad( void ) {
+	playerLoad_t	*pl;
+	clientInfo_t	*ci;
+	int				i, clientNum;
+
+	pl = &cg_playerLoad;
+	for ( i = 1 ; i <= cgs.maxclients ; i++ ) {
+		clientNum = ( pl->clientNum + i ) % cgs.maxclients;
+		ci = &cgs.clientinfo[clientNum];
+		if ( !ci->infoValid || !ci->deferred ) {
+			continue;
+		}
+
+		// someone may have loaded the same models in the meantime
+		if ( CG_ScanForExistingClientInfo( ci ) ) {
+			CG_ClientInfoLoaded( clientNum, ci );
+			continue;
+		}
+
+		// if we are low on memory, leave it deferred
+		if ( trap_MemoryRemaining() < 4000000 ) {
+			CG_Printf( "Memory is low. Using deferred model.\n" );
+			ci->deferred = qfalse;
+			continue;
+		}
+
+		// start from empty handles so a missing skin isn't hidden
+		// by the borrowed ones
+		memset( &pl->info, 0, sizeof( pl->info ) );
+		Q_strncpyz( pl->info.modelName, ci->modelName, sizeof( pl->info.modelName ) );
+		Q_strncpyz( pl->info.skinName, ci->skinName, sizeof( pl->info.skinName ) );
+		Q_strncpyz( pl->info.headModelName, ci->headModelName, sizeof( pl->info.headModelName ) );
+		Q_strncpyz( pl->info.headSkinName, ci->headSkinName, sizeof( pl->info.headSkinName ) );
+		Q_strncpyz( pl->info.redTeam, ci->redTeam, sizeof( pl->info.redTeam ) );
+		Q_strncpyz( pl->info.blueTeam, ci->blueTeam, sizeof( pl->info.blueTeam ) );
+		pl->info.team = ci->team;
+
+		CG_ClientTeamName( ci, pl->teamname, sizeof( pl->teamname ) );
+		CG_ClientModelKey( ci, pl->key, sizeof( pl->key ) );
+		pl->clientNum = clientNum;
+		pl->step = PLOAD_BODY;
+		pl->sound = 0;
+		pl->active = qtrue;
+		return qtrue;
+	}
+
+	return qfalse;
+}
+
+/*
+======================
+CG_PlayerLoadStep
+
+Registers the next part of the player being loaded
+======================
+*/
+static qboolean CG_PlayerLoadStep( playerLoad_t *pl ) {
+	clientInfo_t	*ci;
+	const char		*headName;
+
+	ci = &pl->info;
+	headName = CG_ClientHeadName( ci->modelName, ci->headModelName );
+
+	switch ( pl->step ) {
+	case PLOAD_BODY:
+		if ( !CG_RegisterClientBodyModels( ci, ci->modelName ) ) {
+			return qfalse;
+		}
+		break;
+	case PLOAD_HEAD:
+		if ( !CG_RegisterClientHeadModel( ci, ci->headModelName, headName ) ) {
+			return qfalse;
+		}
+		break;
+	case PLOAD_SKINS:
+		if ( !CG_RegisterClientSkins( ci, ci->modelName, ci->skinName, headName, ci->headSkinName, pl->teamname ) ) {
+			return qfalse;
+		}
+		break;
+	case PLOAD_ANIMATIONS:
+		if ( !CG_LoadClientAnimations( ci, ci->modelName ) ) {
+			return qfalse;
+		}
+		break;
+	case PLOAD_ICON:
+		if ( !CG_RegisterClientIcon( ci, headName, ci->headSkinName, pl->teamname ) ) {
+			return qfalse;
+		}
+		break;
+	case PLOAD_SOUNDS:
+		CG_RegisterClientSounds( ci, qtrue, pl->sound, pl->sound + PLOAD_SOUNDS_PER_STEP );
+		pl->sound += PLOAD_SOUNDS_PER_STEP;
+		if ( pl->sound < MAX_CUSTOM_SOUNDS && cg_customSoundNames[pl->sound] ) {
+			return qtrue;
+		}
+		break;
+	}
+
+	pl->step++;
+	return qtrue;
+}
+
+/*
+======================
+CG_FinishPlayerLoad
+
+Hands the loaded models to the player, unless the player has
+changed models or left while they were loading
+======================
+*/
+static void CG_FinishPlayerLoad( playerLoad_t *pl, qboolean failed ) {
+	clientInfo_t	*ci;
+	char			key[MAX_CLIENTMODEL_KEY];
+
+	pl->active = qfalse;
+
+	ci = &cgs.clientinfo[pl->clientNum];
+	if ( !ci->infoValid || !ci->deferred ) {
+		return;
+	}
+	CG_ClientModelKey( ci, key, sizeof( key ) );
+	if ( strcmp( key, pl->key ) ) {
+		return;
+	}
+
+	if ( failed ) {
+		CG_LoadClientInfo( pl->clientNum, ci );
+		return;
+	}
+
+	CG_CopyClientInfoModel( &pl->info, ci );
+	CG_ClientInfoLoaded( pl->clientNum, ci );
+}
+
+/*
+======================
+CG_RunPlayerLoader
+
+Called every frame, loads deferred players for at most
+cg_playerLoadBudget msec
+======================
+*/
+void CG_RunPlayerLoader( void ) {
+	playerLoad_t	*pl;
+	int				start;
+
+	if ( cg_playerLoadBudget.integer <= 0 ) {
+		return;
+	}
+
+	pl = &cg_playerLoad;
+	start = trap_Milliseconds();
+	do {
+		if ( !pl->active && !CG_StartPlayerLoad() ) {
+			return;
+		}
+
+		if ( !CG_PlayerLoadStep( pl ) ) {
+			CG_FinishPlayerLoad( pl, qtrue );
+		} else if ( pl->step == PLOAD_DONE ) {
+			CG_FinishPlayerLoad( pl, qfalse );
+		}
+	} while ( trap_Milliseconds() - start < cg_playerLoadBudget.integer );
+}
+
+/*
+=============================================================================
+
 PLAYER ANIMATION
 
 =============================================================================
@@ -1903,6 +2370,117 @@ static void CG_PlayerAngles( centity_t *cent, vec3_t legs[3], vec3_t torso[3], v
 }
 
 
+//==========================================================================
+
+/*
+=============================================================================
+
+PLAYER LEVEL OF DETAIL
+
+Players that only cover a few pixels on screen don't need breath puffs,
+dust, shadow traces or an animated flag.  Each player gets a tier from
+its projected height, and the thresholds are pushed out while the scene
+goes over cg_entityBudget / cg_polyBudget so a crowded frame degrades
+the far players first instead of overflowing the renderer.
+
+=============================================================================
+*/
+
+#define	PLOD_FULL				0
+#define	PLOD_REDUCED			1		// no cosmetic effects or extra traces
+#define	PLOD_MINIMAL			2		// cheapest version of every attachment
+
+#define	PLOD_PLAYER_HEIGHT		56		// units, standing player
+#define	PLOD_REDUCED_PIXELS		80
+#define	PLOD_MINIMAL_PIXELS		24
+#define	PLOD_MAX_BIAS			8.0f
+
+/*
+===============
+CG_UpdatePlayerLOD
+
+Called once a frame after the refdef is built
+===============
+*/
+void CG_UpdatePlayerLOD( void ) {
+	int			ents, polys;
+	qboolean	over, under;
+
+	// what the previous frame submitted
+	ents = cg_profileCounters[PROFC_REFENTITIES] - cg.sceneEntityBase;
+	polys = cg_profileCounters[PROFC_POLYS] - cg.scenePolyBase;
+	cg.sceneEntityBase = cg_profileCounters[PROFC_REFENTITIES];
+	cg.scenePolyBase = cg_profileCounters[PROFC_POLYS];
+
+	over = ( cg_entityBudget.integer > 0 && ents > cg_entityBudget.integer ) ||
+		( cg_polyBudget.integer > 0 && polys > cg_polyBudget.integer );
+	under = ( cg_entityBudget.integer <= 0 || ents < cg_entityBudget.integer * 3 / 4 ) &&
+		( cg_polyBudget.integer <= 0 || polys < cg_polyBudget.integer * 3 / 4 );
+
+	if ( cg.playerLODBias < 1.0f ) {
+		cg.playerLODBias = 1.0f;
+	}
+	if ( over ) {
+		cg.playerLODBias *= 1.25f;
+		if ( cg.playerLODBias > PLOD_MAX_BIAS ) {
+			cg.playerLODBias = PLOD_MAX_BIAS;
+		}
+	} else if ( under ) {
+		cg.playerLODBias *= 0.95f;
+		if ( cg.playerLODBias < 1.0f ) {
+			cg.playerLODBias = 1.0f;
+		}
+	}
+
+	cg.playerLODProjection = cg.refdef.height / ( 2 * tan( cg.refdef.fov_y * M_PI / 360.0f ) );
+}
+
+/*
+===============
+CG_PlayerLOD
+===============
+*/
+static int CG_PlayerLOD( centity_t *cent ) {
+	vec3_t	delta;
+	float	dist, pixels, scale;
+
+	if ( !cg_playerLOD.integer ) {
+		return PLOD_FULL;
+	}
+
+	// never degrade the player we are looking through
+	if ( cent->currentState.clientNum == cg.snap->ps.clientNum ) {
+		return PLOD_FULL;
+	}
+
+	// this frame already ran out of budget
+	if ( cg_entityBudget.integer > 0 &&
+		cg_profileCounters[PROFC_REFENTITIES] - cg.sceneEntityBase > cg_entityBudget.integer ) {
+		return PLOD_MINIMAL;
+	}
+	if ( cg_polyBudget.integer > 0 &&
+		cg_profileCounters[PROFC_POLYS] - cg.scenePolyBase > cg_polyBudget.integer ) {
+		return PLOD_MINIMAL;
+	}
+
+	VectorSubtract( cent->lerpOrigin, cg.refdef.vieworg, delta );
+	dist = VectorLength( delta );
+	if ( dist < 1 ) {
+		return PLOD_FULL;
+	}
+
+	pixels = PLOD_PLAYER_HEIGHT * cg.playerLODProjection / dist;
+	scale = cg_playerLODScale.value * cg.playerLODBias;
+
+	if ( pixels < PLOD_MINIMAL_PIXELS * scale ) {
+		return PLOD_MINIMAL;
+	}
+	if ( pixels < PLOD_REDUCED_PIXELS * scale ) {
+		return PLOD_REDUCED;
+	}
+	return PLOD_FULL;
+}
+
 //==========================================================================
 
 /*
@@ -2242,7 +2820,7 @@ static void CG_PlayerTokens( centity_t *cent, int renderfx ) {
 CG_PlayerPowerups
 ===============
 */
-static void CG_PlayerPowerups( centity_t *cent, refEntity_t *torso ) {
+static void CG_PlayerPowerups( centity_t *cent, refEntity_t *torso, int lod ) {
 	int		powerups;
 	clientInfo_t	*ci;
 
@@ -2264,7 +2842,7 @@ static void CG_PlayerPowerups( centity_t *cent, refEntity_t *torso ) {
 	ci = &cgs.clientinfo[ cent->currentState.clientNum ];
 	// redflag
 	if ( powerups & ( 1 << PW_REDFLAG ) ) {
-		if (ci->newAnims) {
+		if ( ci->newAnims && lod != PLOD_MINIMAL ) {
 			CG_PlayerFlag( cent, cgs.media.redFlagFlapSkin, torso );
 		}
 		else {
@@ -2275,7 +2853,7 @@ static void CG_PlayerPowerups( centity_t *cent, refEntity_t *torso ) {
 
 	// blueflag
 	if ( powerups & ( 1 << PW_BLUEFLAG ) ) {
-		if (ci->newAnims){
+		if ( ci->newAnims && lod != PLOD_MINIMAL ) {
 			CG_PlayerFlag( cent, cgs.media.blueFlagFlapSkin, torso );
 		}
 		else {
@@ -2286,7 +2864,7 @@ static void CG_PlayerPowerups( centity_t *cent, refEntity_t *torso ) {
 
 	// neutralflag
 	if ( powerups & ( 1 << PW_NEUTRALFLAG ) ) {
-		if (ci->newAnims) {
+		if ( ci->newAnims && lod != PLOD_MINIMAL ) {
 			CG_PlayerFlag( cent, cgs.media.neutralFlagFlapSkin, torso );
 		}
 		else {
@@ -2296,7 +2874,7 @@ static void CG_PlayerPowerups( centity_t *cent, refEntity_t *torso ) {
 	}
 
 	// haste leaves smoke trails
-	if ( powerups & ( 1 << PW_HASTE ) ) {
+	if ( ( powerups & ( 1 << PW_HASTE ) ) && lod != PLOD_MINIMAL ) {
 		CG_HasteTrail( cent );
 	}
 }
@@ -2679,6 +3257,7 @@ void CG_Player( centity_t *cent ) {
 	float			angle;
 	vec3_t			dir, angles;
 	int camereyes = 0;
+	int				lod;
 	// leilei - chibi hack
 	float chibifactorbody, chibifactortorso, chibifactorhead = 0;
 
@@ -2731,6 +3310,8 @@ void CG_Player( centity_t *cent ) {
 		return;
 	}
 
+	lod = CG_PlayerLOD( cent );
+
 	// get the player model information
 	renderfx = 0;
 
@@ -2761,11 +3342,16 @@ void CG_Player( centity_t *cent ) {
 	// add the talk baloon or disconnect icon
 	CG_PlayerSprites( cent );
 
-	// add the shadow
-	shadow = CG_PlayerShadow( cent, &shadowPlane );
+	if ( lod == PLOD_FULL ) {
+		// add the shadow
+		shadow = CG_PlayerShadow( cent, &shadowPlane );
 
-	// add a water splash if partially in and out of water
-	CG_PlayerSplash( cent );
+		// add a water splash if partially in and out of water
+		CG_PlayerSplash( cent );
+	} else {
+		shadow = qfalse;
+		shadowPlane = 0;
+	}
 
 	if ( cg_shadows.integer == 3 && shadow ) {
 		renderfx |= RF_SHADOW_PLANE;
@@ -2878,8 +3464,10 @@ void CG_Player( centity_t *cent ) {
 
 			skull.hModel = cgs.media.kamikazeHeadModel;
 			trap_R_AddRefEntityToScene( &skull );
-			skull.hModel = cgs.media.kamikazeHeadTrail;
-			trap_R_AddRefEntityToScene( &skull );
+			if ( lod != PLOD_MINIMAL ) {
+				skull.hModel = cgs.media.kamikazeHeadTrail;
+				trap_R_AddRefEntityToScene( &skull );
+			}
 		}
 		else {
 			// three skulls spinning around the player
@@ -2909,8 +3497,10 @@ void CG_Player( centity_t *cent ) {
 			trap_R_AddRefEntityToScene( &skull );
 			// flip the trail because this skull is spinning in the other direction
 			VectorInverse(skull.axis[1]);
-			skull.hModel = cgs.media.kamikazeHeadTrail;
-			trap_R_AddRefEntityToScene( &skull );
+			if ( lod != PLOD_MINIMAL ) {
+				skull.hModel = cgs.media.kamikazeHeadTrail;
+				trap_R_AddRefEntityToScene( &skull );
+			}
 
 			angle = ((cg.time / 4) & 255) * (M_PI * 2) / 255 + M_PI;
 			if (angle > M_PI * 2)
@@ -2937,8 +3527,10 @@ void CG_Player( centity_t *cent ) {
 
 			skull.hModel = cgs.media.kamikazeHeadModel;
 			trap_R_AddRefEntityToScene( &skull );
-			skull.hModel = cgs.media.kamikazeHeadTrail;
-			trap_R_AddRefEntityToScene( &skull );
+			if ( lod != PLOD_MINIMAL ) {
+				skull.hModel = cgs.media.kamikazeHeadTrail;
+				trap_R_AddRefEntityToScene( &skull );
+			}
 
 			angle = ((cg.time / 3) & 255) * (M_PI * 2) / 255 + 0.5 * M_PI;
 			if (angle > M_PI * 2)
@@ -2955,8 +3547,10 @@ void CG_Player( centity_t *cent ) {
 
 			skull.hModel = cgs.media.kamikazeHeadModel;
 			trap_R_AddRefEntityToScene( &skull );
-			skull.hModel = cgs.media.kamikazeHeadTrail;
-			trap_R_AddRefEntityToScene( &skull );
+			if ( lod != PLOD_MINIMAL ) {
+				skull.hModel = cgs.media.kamikazeHeadTrail;
+				trap_R_AddRefEntityToScene( &skull );
+			}
 		}
 	}
 
@@ -3112,9 +3706,11 @@ void CG_Player( centity_t *cent ) {
 	AngleVectors( v, forwaad, NULL, NULL );
 	VectorMA(cent->lerpOrigin, 1024, forwaad, v );
 	VectorCopy(head.origin, orrg);
-	CG_Trace (&trace, orrg, NULL, NULL, v, -1, CONTENTS_SOLID);
-			if (trace.fraction < 1)
-				VectorCopy(trace.endpos, v);				// look closer
+	if ( lod == PLOD_FULL ) {		// nobody can see where distant eyes focus
+		CG_Trace (&trace, orrg, NULL, NULL, v, -1, CONTENTS_SOLID);
+		if (trace.fraction < 1)
+			VectorCopy(trace.endpos, v);				// look closer
+	}
 	VectorCopy(v, head.eyelook);				// Copy it to our refdef for the renderer
 	}
 
@@ -3135,9 +3731,11 @@ void CG_Player( centity_t *cent ) {
 
 	CG_AddRefEntityWithPowerups( &head, &cent->currentState, ci->team, qfalse );
 
-	CG_BreathPuffs(cent, &head);
+	if ( lod == PLOD_FULL ) {
+		CG_BreathPuffs(cent, &head);
 
-	CG_DustTrail(cent);
+		CG_DustTrail(cent);
+	}
 
 	//
 	// add the gun / barrel / flash
@@ -3145,7 +3743,7 @@ void CG_Player( centity_t *cent ) {
 	CG_AddPlayerWeapon( &torso, NULL, cent, ci->team );
 
 	// add powerups floating behind the player
-	CG_PlayerPowerups( cent, &torso );
+	CG_PlayerPowerups( cent, &torso, lod );
 
 }
 
@@ -0,0 +1,307 @@
+/*
+===========================================================================
+Copyright (C) 1999-2005 Id Software, Inc.
+
+This file is part of Quake III Arena source code.
+
+Quake III Arena source code is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of the License,
+or (at your option) any later version.
+
+Quake III Arena source code is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Quake III Arena source code; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+===========================================================================
+*/
+//
+// cg_profile.c -- opt-in timing of the CG_DrawActiveFrame phases
+//
+// Enabled with cg_profile 1.  Every frame is split into phases with
+// CG_ProfilePhase, each phase records the milliseconds it took and how
+// many refEntities, polys and traces were issued while it was active.
+// The last PROFILE_FRAMES frames are kept so the overlay can show
+// rolling averages and worst cases, and "profiledump" writes them out.
+//
+// trap_Milliseconds only has millisecond resolution, so a single frame
+// of a cheap phase usually reads 0 or 1; the averages are what matter.
+
+#include "cg_local.h"
+
+#define	PROFILE_FRAMES		64
+#define	PROFILE_DUMPFILE	"cgprofile.txt"
+
+int		cg_profileCounters[PROFC_NUM_COUNTERS];
+
+typedef struct {
+	int		msec[PROFILE_FRAMES];
+	int		counts[PROFILE_FRAMES][PROFC_NUM_COUNTERS];
+	int		peakMsec;				// worst case since profiling was enabled
+} profPhaseHistory_t;
+
+typedef struct {
+	qboolean	active;				// a frame is currently being recorded
+	int			frameStart;
+	int			phase;
+	int			phaseStart;
+	int			phaseCounters[PROFC_NUM_COUNTERS];
+
+	int			curMsec[PROF_NUM_PHASES];
+	int			curCounts[PROF_NUM_PHASES][PROFC_NUM_COUNTERS];
+
+	int			frameNum;			// number of frames recorded
+	int			frameMsec[PROFILE_FRAMES];
+	int			peakFrameMsec;
+	profPhaseHistory_t	phases[PROF_NUM_PHASES];
+} cgProfile_t;
+
+static cgProfile_t	cg_prof;
+
+static const char *profPhaseNames[PROF_NUM_PHASES] = {
+	"other",
+	"snapshots",
+	"predict",
+	"calcview",
+	"packetents",
+	"marks",
+	"localents",
+	"viewweapon",
+	"sounds",
+	"render3d",
+	"draw2d"
+};
+
+static const char *profCounterNames[PROFC_NUM_COUNTERS] = {
+	"ents",
+	"polys",
+	"traces"
+};
+
+/*
+=================
+CG_ProfileReset
+=================
+*/
+static void CG_ProfileReset( void ) {
+	memset( &cg_prof, 0, sizeof( cg_prof ) );
+}
+
+/*
+=================
+CG_ProfileFrameBegin
+
+Called at the top of CG_DrawActiveFrame.  Everything until the first
+CG_ProfilePhase call is accounted to PROF_OTHER.
+=================
+*/
+void CG_ProfileFrameBegin( void ) {
+	if ( !cg_profile.integer ) {
+		if ( cg_prof.frameNum ) {
+			CG_ProfileReset();
+		}
+		return;
+	}
+
+	memset( cg_prof.curMsec, 0, sizeof( cg_prof.curMsec ) );
+	memset( cg_prof.curCounts, 0, sizeof( cg_prof.curCounts ) );
+
+	cg_prof.active = qtrue;
+	cg_prof.frameStart = trap_Milliseconds();
+	cg_prof.phase = PROF_OTHER;
+	cg_prof.phaseStart = cg_prof.frameStart;
+	memcpy( cg_prof.phaseCounters, cg_profileCounters, sizeof( cg_prof.phaseCounters ) );
+}
+
+/*
+=================
+CG_ProfilePhase
+
+Closes the running phase and charges everything from here on to phase.
+=================
+*/
+void CG_ProfilePhase( profPhase_t phase ) {
+	int		t, i;
+
+	if ( !cg_prof.active ) {
+		return;
+	}
+
+	t = trap_Milliseconds();
+	cg_prof.curMsec[cg_prof.phase] += t - cg_prof.phaseStart;
+	for ( i = 0 ; i < PROFC_NUM_COUNTERS ; i++ ) {
+		cg_prof.curCounts[cg_prof.phase][i] += cg_profileCounters[i] - cg_prof.phaseCounters[i];
+		cg_prof.phaseCounters[i] = cg_profileCounters[i];
+	}
+
+	cg_prof.phase = phase;
+	cg_prof.phaseStart = t;
+}
+
+/*
+=================
+CG_ProfileFrameEnd
+
+Moves the frame that was just recorded into the history.
+=================
+*/
+void CG_ProfileFrameEnd( void ) {
+	profPhaseHistory_t	*ph;
+	int		slot, msec;
+	int		i;
+
+	if ( !cg_prof.active ) {
+		return;
+	}
+
+	CG_ProfilePhase( PROF_OTHER );
+	cg_prof.active = qfalse;
+
+	slot = cg_prof.frameNum % PROFILE_FRAMES;
+	cg_prof.frameNum++;
+
+	msec = cg_prof.phaseStart - cg_prof.frameStart;
+	cg_prof.frameMsec[slot] = msec;
+	if ( msec > cg_prof.peakFrameMsec ) {
+		cg_prof.peakFrameMsec = msec;
+	}
+
+	for ( i = 0, ph = cg_prof.phases ; i < PROF_NUM_PHASES ; i++, ph++ ) {
+		ph->msec[slot] = cg_prof.curMsec[i];
+		memcpy( ph->counts[slot], cg_prof.curCounts[i], sizeof( ph->counts[slot] ) );
+		if ( cg_prof.curMsec[i] > ph->peakMsec ) {
+			ph->peakMsec = cg_prof.curMsec[i];
+		}
+	}
+}
+
+/*
+=================
+CG_ProfileStats
+
+Average and worst case of one phase over the frames in the history.
+counter == -1 reads the milliseconds, phase == -1 the whole frame.
+=================
+*/
+static void CG_ProfileStats( int phase, int counter, float *avg, int *max ) {
+	int		i, frames, v, total;
+
+	frames = cg_prof.frameNum < PROFILE_FRAMES ? cg_prof.frameNum : PROFILE_FRAMES;
+	total = 0;
+	*max = 0;
+	for ( i = 0 ; i < frames ; i++ ) {
+		if ( phase < 0 ) {
+			v = cg_prof.frameMsec[i];
+		} else if ( counter < 0 ) {
+			v = cg_prof.phases[phase].msec[i];
+		} else {
+			v = cg_prof.phases[phase].counts[i][counter];
+		}
+		total += v;
+		if ( v > *max ) {
+			*max = v;
+		}
+	}
+	*avg = frames ? (float)total / frames : 0;
+}
+
+/*
+=================
+CG_DrawProfile
+=================
+*/
+void CG_DrawProfile( void ) {
+	static vec4_t	background = { 0.0f, 0.0f, 0.0f, 0.6f };
+	float	avg, cavg[PROFC_NUM_COUNTERS];
+	int		max, cmax;
+	int		i, j, x, y;
+	char	*s;
+
+	if ( !cg_prof.frameNum ) {
+		return;
+	}
+
+	x = 4;
+	y = 120;
+	CG_FillRect( x, y, 44 * TINYCHAR_WIDTH, ( PROF_NUM_PHASES + 2 ) * TINYCHAR_HEIGHT + 4, background );
+	x += 2;
+	y += 2;
+
+	CG_DrawStringExt( x, y, "phase       avg max  ents polys trace", colorYellow, qtrue, qfalse,
+		TINYCHAR_WIDTH, TINYCHAR_HEIGHT, 0 );
+	y += TINYCHAR_HEIGHT;
+
+	for ( i = 0 ; i < PROF_NUM_PHASES ; i++ ) {
+		CG_ProfileStats( i, -1, &avg, &max );
+		for ( j = 0 ; j < PROFC_NUM_COUNTERS ; j++ ) {
+			CG_ProfileStats( i, j, &cavg[j], &cmax );
+		}
+		s = va( "%-10s %4.1f %3i %5i %5i %5i", profPhaseNames[i], avg, max,
+			(int)cavg[PROFC_REFENTITIES], (int)cavg[PROFC_POLYS], (int)cavg[PROFC_TRACES] );
+		CG_DrawStringExt( x, y, s, colorWhite, qtrue, qfalse, TINYCHAR_WIDTH, TINYCHAR_HEIGHT, 0 );
+		y += TINYCHAR_HEIGHT;
+	}
+
+	CG_ProfileStats( -1, -1, &avg, &max );
+	s = va( "%-10s %4.1f %3i  peak %i", "frame", avg, max, cg_prof.peakFrameMsec );
+	CG_DrawStringExt( x, y, s, colorGreen, qtrue, qfalse, TINYCHAR_WIDTH, TINYCHAR_HEIGHT, 0 );
+}
+
+/*
+=================
+CG_ProfileDump_f
+
+profiledump [filename]
+=================
+*/
+void CG_ProfileDump_f( void ) {
+	fileHandle_t	f;
+	char	filename[MAX_QPATH];
+	float	avg;
+	int		max;
+	int		i, j;
+	char	*s;
+
+	if ( !cg_prof.frameNum ) {
+		CG_Printf( "No profile data, set cg_profile 1 first.\n" );
+		return;
+	}
+
+	if ( trap_Argc() > 1 ) {
+		trap_Argv( 1, filename, sizeof( filename ) );
+	} else {
+		Q_strncpyz( filename, PROFILE_DUMPFILE, sizeof( filename ) );
+	}
+
+	if ( trap_FS_FOpenFile( filename, &f, FS_WRITE ) < 0 || !f ) {
+		CG_Printf( "Couldn't open %s for writing.\n", filename );
+		return;
+	}
+
+	s = va( "map %s, time %i, %i frames recorded, last %i used\n\n", cgs.mapname, cg.time,
+		cg_prof.frameNum, cg_prof.frameNum < PROFILE_FRAMES ? cg_prof.frameNum : PROFILE_FRAMES );
+	trap_FS_Write( s, strlen( s ), f );
+
+	for ( i = 0 ; i < PROF_NUM_PHASES ; i++ ) {
+		CG_ProfileStats( i, -1, &avg, &max );
+		s = va( "%-10s msec avg %.2f max %i peak %i\n", profPhaseNames[i], avg, max,
+			cg_prof.phases[i].peakMsec );
+		trap_FS_Write( s, strlen( s ), f );
+		for ( j = 0 ; j < PROFC_NUM_COUNTERS ; j++ ) {
+			CG_ProfileStats( i, j, &avg, &max );
+			s = va( "%-10s %-6s avg %.1f max %i\n", "", profCounterNames[j], avg, max );
+			trap_FS_Write( s, strlen( s ), f );
+		}
+	}
+
+	CG_ProfileStats( -1, -1, &avg, &max );
+	s = va( "\nframe      msec avg %.2f max %i peak %i\n", avg, max, cg_prof.peakFrameMsec );
+	trap_FS_Write( s, strlen( s ), f );
+
+	trap_FS_FCloseFile( f );
+	CG_Printf( "Wrote profile to %s\n", filename );
+}
@@ -342,43 +342,45 @@ and whenever the server updates any serverinfo flagged cvars
 */
 void CG_ParseServerinfo( void ) {
 	const char	*info;
+	infoView_t	view;
 	char	*mapname;
 
 	info = CG_ConfigString( CS_SERVERINFO );
-	cgs.gametype = atoi( Info_ValueForKey( info, "g_gametype" ) );
+	Info_Parse( &view, info );
+	cgs.gametype = atoi( Info_ViewValue( &view, "g_gametype" ) );
 	//By default do as normal:
 	cgs.ffa_gt = 0;
 	//See if ffa gametype
 	if(cgs.gametype == GT_LMS)	
 		cgs.ffa_gt = 1;
 	trap_Cvar_Set("g_gametype", va("%i", cgs.gametype));
-	cgs.dmflags = atoi( Info_ValueForKey( info, "dmflags" ) );
-        cgs.videoflags = atoi( Info_ValueForKey( info, "videoflags" ) );
-        cgs.elimflags = atoi( Info_ValueForKey( info, "elimflags" ) );
-	cgs.teamflags = atoi( Info_ValueForKey( info, "teamflags" ) );
-	cgs.fraglimit = atoi( Info_ValueForKey( info, "fraglimit" ) );
-	cgs.capturelimit = atoi( Info_ValueForKey( info, "capturelimit" ) );
-	cgs.timelimit = atoi( Info_ValueForKey( info, "timelimit" ) );
-	cgs.maxclients = atoi( Info_ValueForKey( info, "sv_maxclients" ) );
-	cgs.roundtime = atoi( Info_ValueForKey( info, "elimination_roundtime" ) );
-	cgs.nopickup = atoi( Info_ValueForKey( info, "g_rockets" ) ) + atoi( Info_ValueForKey( info, "g_instantgib" ) ) + atoi( Info_ValueForKey( info, "g_elimination" ) );
-	cgs.lms_mode = atoi( Info_ValueForKey( info, "g_lms_mode" ) );
-	cgs.altExcellent = atoi( Info_ValueForKey( info, "g_altExcellent" ) );
-	mapname = Info_ValueForKey( info, "mapname" );
+	cgs.dmflags = atoi( Info_ViewValue( &view, "dmflags" ) );
+        cgs.videoflags = atoi( Info_ViewValue( &view, "videoflags" ) );
+        cgs.elimflags = atoi( Info_ViewValue( &view, "elimflags" ) );
+	cgs.teamflags = atoi( Info_ViewValue( &view, "teamflags" ) );
+	cgs.fraglimit = atoi( Info_ViewValue( &view, "fraglimit" ) );
+	cgs.capturelimit = atoi( Info_ViewValue( &view, "capturelimit" ) );
+	cgs.timelimit = atoi( Info_ViewValue( &view, "timelimit" ) );
+	cgs.maxclients = atoi( Info_ViewValue( &view, "sv_maxclients" ) );
+	cgs.roundtime = atoi( Info_ViewValue( &view, "elimination_roundtime" ) );
+	cgs.nopickup = atoi( Info_ViewValue( &view, "g_rockets" ) ) + atoi( Info_ViewValue( &view, "g_instantgib" ) ) + atoi( Info_ViewValue( &view, "g_elimination" ) );
+	cgs.lms_mode = atoi( Info_ViewValue( &view, "g_lms_mode" ) );
+	cgs.altExcellent = atoi( Info_ViewValue( &view, "g_altExcellent" ) );
+	mapname = Info_ViewValue( &view, "mapname" );
 	Com_sprintf( cgs.mapname, sizeof( cgs.mapname ), "maps/%s.bsp", mapname );
-	Q_strncpyz( cgs.redTeam, Info_ValueForKey( info, "g_redTeam" ), sizeof(cgs.redTeam) );
+	Q_strncpyz( cgs.redTeam, Info_ViewValue( &view, "g_redTeam" ), sizeof(cgs.redTeam) );
 	trap_Cvar_Set("g_redTeam", cgs.redTeam);
-	Q_strncpyz( cgs.blueTeam, Info_ValueForKey( info, "g_blueTeam" ), sizeof(cgs.blueTeam) );
+	Q_strncpyz( cgs.blueTeam, Info_ViewValue( &view, "g_blueTeam" ), sizeof(cgs.blueTeam) );
 	trap_Cvar_Set("g_blueTeam", cgs.blueTeam);
 
 //unlagged - server options
 	// we'll need this for deciding whether or not to predict weapon effects
-	cgs.delagHitscan = atoi( Info_ValueForKey( info, "g_delagHitscan" ) );
+	cgs.delagHitscan = atoi( Info_ViewValue( &view, "g_delagHitscan" ) );
 	trap_Cvar_Set("g_delagHitscan", va("%i", cgs.delagHitscan));
 //unlagged - server options
 
         //Copy allowed votes directly to the client:
-        trap_Cvar_Set("cg_voteflags",Info_ValueForKey( info, "voteflags" ) );
+        trap_Cvar_Set("cg_voteflags",Info_ViewValue( &view, "voteflags" ) );
 }
 
 /*
@@ -699,6 +701,7 @@ static void CG_MapRestart( void ) {
 #define MAX_VOICESOUNDS		64
 #define MAX_CHATSIZE		64
 #define MAX_HEADMODELS		64
+#define VOICECHAT_HASH_SIZE	128		// power of two, > MAX_VOICECHATS
 
 typedef struct voiceChat_s
 {
@@ -706,6 +709,7 @@ typedef struct voiceChat_s
 	int numSounds;
 	sfxHandle_t sounds[MAX_VOICESOUNDS];
 	char chats[MAX_VOICESOUNDS][MAX_CHATSIZE];
+	int hashNext;					// 1 + next voice chat in the bucket, 0 = end
 } voiceChat_t;
 
 typedef struct voiceChatList_s
@@ -714,6 +718,7 @@ typedef struct voiceChatList_s
 	int gender;
 	int numVoiceChats;
 	voiceChat_t voiceChats[MAX_VOICECHATS];
+	int hashTable[VOICECHAT_HASH_SIZE];	// 1 + first voice chat with that id hash
 } voiceChatList_t;
 
 typedef struct headModelVoiceChat_s
@@ -725,6 +730,26 @@ typedef struct headModelVoiceChat_s
 voiceChatList_t voiceChatLists[MAX_VOICEFILES];
 headModelVoiceChat_t headModelVoiceChat[MAX_HEADMODELS];
 
+/*
+=================
+CG_HashVoiceChat
+
+Chains a parsed voice chat into its list's id hash.  Chats are added in
+file order and go to the end of the chain, so when an id appears twice
+the first one still wins like it did with the linear search.
+=================
+*/
+static void CG_HashVoiceChat( voiceChatList_t *voiceChatList, int num ) {
+	int		*link;
+
+	voiceChatList->voiceChats[num].hashNext = 0;
+	link = &voiceChatList->hashTable[Q_HashString( voiceChatList->voiceChats[num].id ) & ( VOICECHAT_HASH_SIZE - 1 )];
+	while ( *link ) {
+		link = &voiceChatList->voiceChats[*link - 1].hashNext;
+	}
+	*link = num + 1;
+}
+
 /*
 =================
 CG_ParseVoiceChats
@@ -768,6 +793,7 @@ int CG_ParseVoiceChats( const char *filename, voiceChatList_t *voiceChatList, in
 	for ( i = 0; i < maxVoiceChats; i++ ) {
 		voiceChats[i].id[0] = 0;
 	}
+	memset( voiceChatList->hashTable, 0, sizeof( voiceChatList->hashTable ) );
 	token = COM_ParseExt(p, qtrue);
 	if (!token || token[0] == 0) {
 		return qtrue;
@@ -819,6 +845,7 @@ int CG_ParseVoiceChats( const char *filename, voiceChatList_t *voiceChatList, in
 			if (voiceChats[voiceChatList->numVoiceChats].numSounds >= MAX_VOICESOUNDS)
 				break;
 		}
+		CG_HashVoiceChat( voiceChatList, voiceChatList->numVoiceChats );
 		voiceChatList->numVoiceChats++;
 		if (voiceChatList->numVoiceChats >= maxVoiceChats)
 			return qtrue;
@@ -900,12 +927,14 @@ CG_GetVoiceChat
 */
 int CG_GetVoiceChat( voiceChatList_t *voiceChatList, const char *id, sfxHandle_t *snd, char **chat) {
 	int i, rnd;
-
-	for ( i = 0; i < voiceChatList->numVoiceChats; i++ ) {
-		if ( !Q_stricmp( id, voiceChatList->voiceChats[i].id ) ) {
-			rnd = random() * voiceChatList->voiceChats[i].numSounds;
-			*snd = voiceChatList->voiceChats[i].sounds[rnd];
-			*chat = voiceChatList->voiceChats[i].chats[rnd];
+	voiceChat_t *voiceChat;
+
+	for ( i = voiceChatList->hashTable[Q_HashString( id ) & ( VOICECHAT_HASH_SIZE - 1 )]; i; i = voiceChat->hashNext ) {
+		voiceChat = &voiceChatList->voiceChats[i - 1];
+		if ( !Q_stricmp( id, voiceChat->id ) ) {
+			rnd = random() * voiceChat->numSounds;
+			*snd = voiceChat->sounds[rnd];
+			*chat = voiceChat->chats[rnd];
 			return qtrue;
 		}
 	}
@@ -28,6 +28,18 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "cg_local.h"
 
+// the cg_profile counting wrappers from cg_local.h
+#undef trap_CM_BoxTrace
+#undef trap_CM_TransformedBoxTrace
+#undef trap_R_AddRefEntityToScene
+#undef trap_R_AddPolyToScene
+#undef trap_R_AddPolysToScene
+#ifdef MISSIONPACK
+// the paint cache wrappers
+#undef trap_R_SetColor
+#undef trap_R_DrawStretchPic
+#endif
+
 static intptr_t (QDECL *syscall)( intptr_t arg, ... ) = (intptr_t (QDECL *)( intptr_t, ...))-1;
 
 
@@ -902,6 +902,8 @@ void CG_DrawActiveFrame( int serverTime, stereoFrame_t stereoView, qboolean demo
 	// update cvars
 	CG_UpdateCvars();
 
+	CG_ProfileFrameBegin();
+
 	// if we are only updating the screen as a loading
 	// pacifier, don't even try to read snapshots
 	if ( cg.infoScreenText[0] != 0 ) {
@@ -912,6 +914,7 @@ void CG_DrawActiveFrame( int serverTime, stereoFrame_t stereoView, qboolean demo
 		CG_DrawInformation();
 #endif
 // end loadingscreen
+		CG_ProfileFrameEnd();
 		return;
 	}
 
@@ -923,7 +926,9 @@ void CG_DrawActiveFrame( int serverTime, stereoFrame_t stereoView, qboolean demo
 	trap_R_ClearScene();
 
 	// set up cg.snap and possibly cg.nextSnap
+	CG_ProfilePhase( PROF_SNAPSHOTS );
 	CG_ProcessSnapshots();
+	CG_ProfilePhase( PROF_OTHER );
 
 	// if we haven't received any snapshots yet, all
 	// we can draw is the information screen
@@ -935,6 +940,7 @@ void CG_DrawActiveFrame( int serverTime, stereoFrame_t stereoView, qboolean demo
 		CG_DrawInformation();
 #endif
 // end loadingscreen
+		CG_ProfileFrameEnd();
 		return;
 	}
 
@@ -944,8 +950,13 @@ void CG_DrawActiveFrame( int serverTime, stereoFrame_t stereoView, qboolean demo
 	// this counter will be bumped for every valid scene we generate
 	cg.clientFrame++;
 
+	// spend a little time on players still using borrowed models
+	CG_RunPlayerLoader();
+
 	// update cg.predictedPlayerState
+	CG_ProfilePhase( PROF_PREDICT );
 	CG_PredictPlayerState();
+	CG_ProfilePhase( PROF_OTHER );
 
 	// decide on third person view
 
@@ -955,6 +966,7 @@ void CG_DrawActiveFrame( int serverTime, stereoFrame_t stereoView, qboolean demo
 	cg.renderingThirdPerson = cg_thirdPerson.integer || (cg.snap->ps.stats[STAT_HEALTH] <= 0);
 
 	// build cg.refdef
+	CG_ProfilePhase( PROF_CALCVIEW );
 	inwater = CG_CalcViewValues();
 
 	// first person blend blobs, done after AnglesToAxis
@@ -962,19 +974,28 @@ void CG_DrawActiveFrame( int serverTime, stereoFrame_t stereoView, qboolean demo
 		CG_DamageBlendBlob();
 	}
 
+	// pick player detail levels for this view
+	CG_UpdatePlayerLOD();
+
 	// build the render lists
 	if ( !cg.hyperspace ) {
+		CG_ProfilePhase( PROF_PACKETENTITIES );
 		CG_AddPacketEntities();			// adter calcViewValues, so predicted player state is correct
+		CG_ProfilePhase( PROF_MARKS );
 		CG_AddMarks();
+		CG_ProfilePhase( PROF_LOCALENTITIES );
 		CG_AddLocalEntities();
 	}
+	CG_ProfilePhase( PROF_VIEWWEAPON );
 	CG_AddViewWeapon( &cg.predictedPlayerState );
 
 	// add buffered sounds
+	CG_ProfilePhase( PROF_SOUNDS );
 	CG_PlayBufferedSounds();
 
 	// play buffered voice chats
 	CG_PlayBufferedVoiceChats();
+	CG_ProfilePhase( PROF_OTHER );
 
 	// finish up the rest of the refdef
 	if ( cg.testModelEntity.hModel ) {
@@ -1021,6 +1042,7 @@ void CG_DrawActiveFrame( int serverTime, stereoFrame_t stereoView, qboolean demo
 		CG_Printf( "cg.clientFrame:%i\n", cg.clientFrame );
 	}
 
+	CG_ProfileFrameEnd();
 
 }
 
@@ -67,7 +67,6 @@ BotNumActivePlayers
 */
 int BotNumActivePlayers(void) {
 	int i, num;
-	char buf[MAX_INFO_STRING];
 	static int maxclients;
 
 	if (!maxclients)
@@ -75,11 +74,8 @@ int BotNumActivePlayers(void) {
 
 	num = 0;
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//
 		num++;
 	}
@@ -93,7 +89,6 @@ BotIsFirstInRankings
 */
 int BotIsFirstInRankings(bot_state_t *bs) {
 	int i, score;
-	char buf[MAX_INFO_STRING];
 	static int maxclients;
 	playerState_t ps;
 
@@ -102,11 +97,8 @@ int BotIsFirstInRankings(bot_state_t *bs) {
 
 	score = bs->cur_ps.persistant[PERS_SCORE];
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//
 		BotAI_GetClientState(i, &ps);
 		if (score < ps.persistant[PERS_SCORE]) return qfalse;
@@ -121,7 +113,6 @@ BotIsLastInRankings
 */
 int BotIsLastInRankings(bot_state_t *bs) {
 	int i, score;
-	char buf[MAX_INFO_STRING];
 	static int maxclients;
 	playerState_t ps;
 
@@ -130,11 +121,8 @@ int BotIsLastInRankings(bot_state_t *bs) {
 
 	score = bs->cur_ps.persistant[PERS_SCORE];
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//
 		BotAI_GetClientState(i, &ps);
 		if (score > ps.persistant[PERS_SCORE]) return qfalse;
@@ -149,7 +137,6 @@ BotFirstClientInRankings
 */
 char *BotFirstClientInRankings(void) {
 	int i, bestscore, bestclient;
-	char buf[MAX_INFO_STRING];
 	static char name[32];
 	static int maxclients;
 	playerState_t ps;
@@ -160,11 +147,8 @@ char *BotFirstClientInRankings(void) {
 	bestscore = -999999;
 	bestclient = 0;
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//
 		BotAI_GetClientState(i, &ps);
 		if (ps.persistant[PERS_SCORE] > bestscore) {
@@ -183,7 +167,6 @@ BotLastClientInRankings
 */
 char *BotLastClientInRankings(void) {
 	int i, worstscore, bestclient;
-	char buf[MAX_INFO_STRING];
 	static char name[32];
 	static int maxclients;
 	playerState_t ps;
@@ -194,11 +177,8 @@ char *BotLastClientInRankings(void) {
 	worstscore = 999999;
 	bestclient = 0;
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//
 		BotAI_GetClientState(i, &ps);
 		if (ps.persistant[PERS_SCORE] < worstscore) {
@@ -217,7 +197,6 @@ BotRandomOpponentName
 */
 char *BotRandomOpponentName(bot_state_t *bs) {
 	int i, count;
-	char buf[MAX_INFO_STRING];
 	int opponents[MAX_CLIENTS], numopponents;
 	static int maxclients;
 	static char name[32];
@@ -230,11 +209,8 @@ char *BotRandomOpponentName(bot_state_t *bs) {
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
 		if (i == bs->client) continue;
 		//
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//skip team mates
 		if (BotSameTeam(bs, i)) continue;
 		//
@@ -1497,18 +1497,105 @@ int BotPointAreaNum(vec3_t origin) {
 
 /*
 ==================
-ClientName
+BotUpdateRoster
+
+The player config strings are read once a frame into a roster all
+bots share, together with the area each player is in and the travel
+times to the goals the team AI asks about, which are filled in the
+first time they are asked for.
 ==================
 */
-char *ClientName(int client, char *name, int size) {
+static bot_rosterclient_t botroster[MAX_CLIENTS];
+static int botrostertime = -1;
+
+void BotUpdateRoster(void) {
+	int i;
 	char buf[MAX_INFO_STRING];
+	bot_rosterclient_t *rc;
 
+	for (i = 0; i < MAX_CLIENTS; i++) {
+		rc = &botroster[i];
+		memset(rc, 0, sizeof(*rc));
+		if (i >= maxclients) continue;
+		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
+		Q_strncpyz(rc->name, Info_ValueForKey(buf, "n"), sizeof(rc->name));
+		Q_strncpyz(rc->cleanname, rc->name, sizeof(rc->cleanname));
+		Q_CleanStr(rc->cleanname);
+		//if no config string or no name
+		rc->inuse = ( buf[0] && rc->name[0] );
+		rc->team = atoi(Info_ValueForKey(buf, "t"));
+		rc->areatime = -1;
+	}
+	botrostertime = level.time;
+}
+
+/*
+==================
+BotRosterClient
+==================
+*/
+bot_rosterclient_t *BotRosterClient(int client) {
+	if (botrostertime != level.time) BotUpdateRoster();
+	return &botroster[client];
+}
+
+/*
+==================
+BotRosterPlaying
+
+qtrue if the client has a name and isn't a spectator
+==================
+*/
+int BotRosterPlaying(int client) {
+	bot_rosterclient_t *rc;
+
+	if (client < 0 || client >= MAX_CLIENTS) return qfalse;
+	rc = BotRosterClient(client);
+	return rc->inuse && rc->team != TEAM_SPECTATOR;
+}
+
+/*
+==================
+BotRosterTravelTime
+==================
+*/
+int BotRosterTravelTime(int client, bot_goal_t *goal) {
+	bot_rosterclient_t *rc;
+	playerState_t ps;
+	int i, traveltime;
+
+	rc = BotRosterClient(client);
+	if (rc->areatime != botrostertime) {
+		BotAI_GetClientState(client, &ps);
+		VectorCopy(ps.origin, rc->origin);
+		rc->areanum = BotPointAreaNum(ps.origin);
+		rc->numtraveltimes = 0;
+		rc->areatime = botrostertime;
+	}
+	if (!rc->areanum) return 1;
+	for (i = 0; i < rc->numtraveltimes; i++) {
+		if (rc->goalareas[i] == goal->areanum) return rc->traveltimes[i];
+	}
+	traveltime = trap_AAS_AreaTravelTimeToGoalArea(rc->areanum, rc->origin, goal->areanum, TFL_DEFAULT);
+	if (rc->numtraveltimes < MAX_ROSTERGOALS) {
+		rc->goalareas[rc->numtraveltimes] = goal->areanum;
+		rc->traveltimes[rc->numtraveltimes] = traveltime;
+		rc->numtraveltimes++;
+	}
+	return traveltime;
+}
+
+/*
+==================
+ClientName
+==================
+*/
+char *ClientName(int client, char *name, int size) {
 	if (client < 0 || client >= MAX_CLIENTS) {
 		BotAI_Print(PRT_ERROR, "ClientName: client out of range\n");
 		return "[client out of range]";
 	}
-	trap_GetConfigstring(CS_PLAYERS+client, buf, sizeof(buf));
-	strncpy(name, Info_ValueForKey(buf, "n"), size-1);
+	strncpy(name, BotRosterClient(client)->name, size-1);
 	name[size-1] = '\0';
 	Q_CleanStr( name );
 	return name;
@@ -1539,15 +1626,9 @@ ClientFromName
 */
 int ClientFromName(char *name) {
 	int i;
-	char buf[MAX_INFO_STRING];
-	static int maxclients;
 
-	if (!maxclients)
-		maxclients = trap_Cvar_VariableIntegerValue("sv_maxclients");
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		Q_CleanStr( buf );
-		if (!Q_stricmp(Info_ValueForKey(buf, "n"), name)) return i;
+		if (!Q_stricmp(BotRosterClient(i)->cleanname, name)) return i;
 	}
 	return -1;
 }
@@ -1559,17 +1640,11 @@ ClientOnSameTeamFromName
 */
 int ClientOnSameTeamFromName(bot_state_t *bs, char *name) {
 	int i;
-	char buf[MAX_INFO_STRING];
-	static int maxclients;
 
-	if (!maxclients)
-		maxclients = trap_Cvar_VariableIntegerValue("sv_maxclients");
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
 		if (!BotSameTeam(bs, i))
 			continue;
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		Q_CleanStr( buf );
-		if (!Q_stricmp(Info_ValueForKey(buf, "n"), name)) return i;
+		if (!Q_stricmp(BotRosterClient(i)->cleanname, name)) return i;
 	}
 	return -1;
 }
@@ -2183,10 +2258,8 @@ BotIsObserver
 ==================
 */
 qboolean BotIsObserver(bot_state_t *bs) {
-	char buf[MAX_INFO_STRING];
 	if (bs->cur_ps.pm_type == PM_SPECTATOR) return qtrue;
-	trap_GetConfigstring(CS_PLAYERS+bs->client, buf, sizeof(buf));
-	if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) return qtrue;
+	if (BotRosterClient(bs->client)->team == TEAM_SPECTATOR) return qtrue;
 	return qfalse;
 }
 
@@ -166,6 +166,29 @@ bot_waypoint_t *BotCreateWayPoint(char *name, vec3_t origin, int areanum);
 bot_waypoint_t *BotFindWayPoint(bot_waypoint_t *waypoints, char *name);
 //strstr but case insensitive
 char *stristr(char *str, char *charset);
+//per frame roster of the players shared by all bots
+#define MAX_ROSTERGOALS		4
+typedef struct bot_rosterclient_s
+{
+	int inuse;										//has a config string with a name
+	int team;										//team from the config string
+	char name[MAX_NETNAME];							//name from the config string
+	char cleanname[MAX_NETNAME];					//name without color codes
+	int areatime;									//roster time the area was found
+	int areanum;									//area the client is in
+	vec3_t origin;									//origin the area was found for
+	int numtraveltimes;
+	int goalareas[MAX_ROSTERGOALS];					//goal areas with a known travel time
+	int traveltimes[MAX_ROSTERGOALS];
+} bot_rosterclient_t;
+
+//rebuilds the roster, done at the start of every bot frame
+void BotUpdateRoster(void);
+bot_rosterclient_t *BotRosterClient(int client);
+//returns true if the client has a name and isn't a spectator
+int BotRosterPlaying(int client);
+//travel time from where the client is this frame to the goal
+int BotRosterTravelTime(int client, bot_goal_t *goal);
 //returns the number of the client with the given name
 int ClientFromName(char *name);
 int ClientOnSameTeamFromName(bot_state_t *bs, char *name);
@@ -698,10 +698,30 @@ void BotInterbreeding(void) {
 /*
 ==============
 BotEntityInfo
+
+The botlib only changes its entity info when the entities are updated
+at the start of a bot frame, so every entity is copied out of it at
+most once per update and served from here to all bots after that.
 ==============
 */
+static aas_entityinfo_t	botentityinfo[MAX_GENTITIES];
+static int				botentityinfocount[MAX_GENTITIES];	//update the info is from
+static int				botentityupdatecount = 1;
+
+void BotInvalidateEntityInfo(void) {
+	botentityupdatecount++;
+}
+
 void BotEntityInfo(int entnum, aas_entityinfo_t *info) {
-	trap_AAS_EntityInfo(entnum, info);
+	if (entnum < 0 || entnum >= MAX_GENTITIES) {
+		trap_AAS_EntityInfo(entnum, info);
+		return;
+	}
+	if (botentityinfocount[entnum] != botentityupdatecount) {
+		trap_AAS_EntityInfo(entnum, &botentityinfo[entnum]);
+		botentityinfocount[entnum] = botentityupdatecount;
+	}
+	memcpy(info, &botentityinfo[entnum], sizeof(aas_entityinfo_t));
 }
 
 /*
@@ -1395,6 +1415,7 @@ int BotAILoadMap( int restart ) {
 		trap_Cvar_Register( &mapname, "mapname", "", CVAR_SERVERINFO | CVAR_ROM );
 		trap_BotLibLoadMap( mapname.string );
 	}
+	BotInvalidateEntityInfo();
 
 	for (i = 0; i < MAX_CLIENTS; i++) {
 		if (botstates[i] && botstates[i]->inuse) {
@@ -1437,6 +1458,9 @@ int BotAIStartFrame(int time) {
 	trap_Cvar_Update(&bot_pause);
 	trap_Cvar_Update(&bot_report);
 
+	//read the player config strings once for all bots
+	BotUpdateRoster();
+
 	if (bot_report.integer) {
 //		BotTeamplayReport();
 //		trap_Cvar_Set("bot_report", "0");
@@ -1495,6 +1519,8 @@ int BotAIStartFrame(int time) {
 		botlib_residual -= thinktime;
 
 		trap_BotLibStartFrame((float) time / 1000);
+		//nothing reads entity info until the entities below are updated
+		BotInvalidateEntityInfo();
 
 		if (!trap_AAS_Initialized()) return qfalse;
 
@@ -294,6 +294,8 @@ void BotResetState(bot_state_t *bs);
 int NumBots(void);
 //returns info about the entity
 void BotEntityInfo(int entnum, aas_entityinfo_t *info);
+//makes BotEntityInfo fetch the info from the botlib again
+void BotInvalidateEntityInfo(void);
 
 extern float floattime;
 #define FloatTime() floattime
@@ -82,7 +82,6 @@ BotNumTeamMates
 */
 int BotNumTeamMates(bot_state_t *bs) {
 	int i, numplayers;
-	char buf[MAX_INFO_STRING];
 	static int maxclients;
 
 	if (!maxclients)
@@ -90,11 +89,8 @@ int BotNumTeamMates(bot_state_t *bs) {
 
 	numplayers = 0;
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//
 		if (BotSameTeam(bs, i)) {
 			numplayers++;
@@ -109,13 +105,8 @@ BotClientTravelTimeToGoal
 ==================
 */
 int BotClientTravelTimeToGoal(int client, bot_goal_t *goal) {
-	playerState_t ps;
-	int areanum;
-
-	BotAI_GetClientState(client, &ps);
-	areanum = BotPointAreaNum(ps.origin);
-	if (!areanum) return 1;
-	return trap_AAS_AreaTravelTimeToGoalArea(areanum, ps.origin, goal->areanum, TFL_DEFAULT);
+	//every bot on the team asks for the same travel times
+	return BotRosterTravelTime(client, goal);
 }
 
 /*
@@ -126,7 +117,6 @@ BotSortTeamMatesByBaseTravelTime
 int BotSortTeamMatesByBaseTravelTime(bot_state_t *bs, int *teammates, int maxteammates) {
 
 	int i, j, k, numteammates, traveltime;
-	char buf[MAX_INFO_STRING];
 	static int maxclients;
 	int traveltimes[MAX_CLIENTS];
 	bot_goal_t *goal = NULL;
@@ -148,11 +138,8 @@ int BotSortTeamMatesByBaseTravelTime(bot_state_t *bs, int *teammates, int maxtea
 
 	numteammates = 0;
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//
 		if (BotSameTeam(bs, i)) {
 			//
@@ -185,7 +172,6 @@ For Double Domination
 int BotSortTeamMatesByRelativeTravelTime2ddA(bot_state_t *bs, int *teammates, int maxteammates) {
 	int i, j, k, numteammates;
 	double traveltime, traveltime2b;
-	char buf[MAX_INFO_STRING];
 	static int maxclients;
 	double traveltimes[MAX_CLIENTS];
 	//int traveltimes2b[MAX_CLIENTS];
@@ -198,11 +184,8 @@ int BotSortTeamMatesByRelativeTravelTime2ddA(bot_state_t *bs, int *teammates, in
 	numteammates = 0;
 
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		if (BotSameTeam(bs, i)) {
 			traveltime = (double)BotClientTravelTimeToGoal(i, goalA);
 			traveltime2b = (double)BotClientTravelTimeToGoal(i, goalB);
@@ -1045,7 +1028,6 @@ BotTeamOrders
 void BotTeamOrders(bot_state_t *bs) {
 	int teammates[MAX_CLIENTS];
 	int numteammates, i;
-	char buf[MAX_INFO_STRING];
 	static int maxclients;
 
 	if (!maxclients)
@@ -1053,11 +1035,8 @@ void BotTeamOrders(bot_state_t *bs) {
 
 	numteammates = 0;
 	for (i = 0; i < maxclients && i < MAX_CLIENTS; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
-		//if no config string or no name
-		if (!strlen(buf) || !strlen(Info_ValueForKey(buf, "n"))) continue;
-		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		//if no config string or no name, or a spectator
+		if (!BotRosterPlaying(i)) continue;
 		//
 		if (BotSameTeam(bs, i)) {
 			teammates[numteammates] = i;
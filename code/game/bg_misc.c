@@ -1785,3 +1785,433 @@ char *BG_TeamName( team_t team )
     return "Free For All";
   return "<team>";
 }
+
+/*
+============
+BG_HashInfoValue
+============
+*/
+static int BG_HashInfoValue( const char *value ) {
+	unsigned	hash;
+
+	hash = 2166136261u;
+	while ( *value ) {
+		hash = ( hash ^ (unsigned char)tolower( *value ) ) * 16777619u;
+		value++;
+	}
+	return hash & ( INFO_INDEX_HASH - 1 );
+}
+
+/*
+============
+BG_InitInfoIndex
+============
+*/
+void BG_InitInfoIndex( infoIndex_t *index ) {
+	memset( index->first, 0, sizeof( index->first ) );
+	memset( index->value, 0, sizeof( index->value ) );
+	index->poolUsed = 0;
+	index->overflow = qfalse;
+}
+
+/*
+============
+BG_AddToInfoIndex
+
+Stores value for info number num.  If another info already has the
+value, lookups keep finding the earlier one, as a linear search would.
+============
+*/
+void BG_AddToInfoIndex( infoIndex_t *index, int num, const char *value ) {
+	int			len, hash;
+	qboolean	taken;
+
+	if ( num < 0 || num >= MAX_INDEXED_INFOS ) {
+		index->overflow = qtrue;
+		return;
+	}
+
+	len = strlen( value ) + 1;
+	if ( index->poolUsed + len > INFO_INDEX_POOL ) {
+		index->overflow = qtrue;
+		return;
+	}
+
+	taken = ( BG_FindInInfoIndex( index, value ) >= 0 );
+
+	memcpy( index->pool + index->poolUsed, value, len );
+	index->value[num] = index->poolUsed + 1;
+	index->poolUsed += len;
+
+	if ( taken ) {
+		return;
+	}
+
+	hash = BG_HashInfoValue( value );
+	index->next[num] = index->first[hash];
+	index->first[hash] = num + 1;
+}
+
+/*
+============
+BG_FindInInfoIndex
+
+Returns the info number, or -1 if no indexed info has that value
+============
+*/
+int BG_FindInInfoIndex( const infoIndex_t *index, const char *value ) {
+	int		i;
+
+	for ( i = index->first[BG_HashInfoValue( value )] ; i ; i = index->next[i-1] ) {
+		if ( !Q_stricmp( index->pool + index->value[i-1] - 1, value ) ) {
+			return i - 1;
+		}
+	}
+	return -1;
+}
+
+/*
+============
+BG_InfoIndexValue
+
+NULL if info number num isn't in the index
+============
+*/
+const char *BG_InfoIndexValue( const infoIndex_t *index, int num ) {
+	if ( num < 0 || num >= MAX_INDEXED_INFOS || !index->value[num] ) {
+		return NULL;
+	}
+	return index->pool + index->value[num] - 1;
+}
+
+/*
+=============================================================================
+
+MODEL CATALOG
+
+Finding the icons means a file listing for every directory under
+models/players, which takes seconds once a few hundred models are
+installed.  The icons found are kept in MODELCATALOG_FILE with a hash of
+the pk3 listing.  While the pk3s stay the same, only directories that
+aren't in the catalog yet are listed again, and directories that are
+gone are dropped from it.
+
+=============================================================================
+*/
+
+#define MODELCATALOG_FILE		"playermodels.cat"
+#define MODELCATALOG_IDENT		"PLAYERMODELS"
+#define MODELCATALOG_VERSION	1
+
+int		trap_FS_FOpenFile( const char *qpath, fileHandle_t *f, fsMode_t mode );
+void	trap_FS_Read( void *buffer, int len, fileHandle_t f );
+void	trap_FS_Write( const void *buffer, int len, fileHandle_t f );
+void	trap_FS_FCloseFile( fileHandle_t f );
+
+/*
+============
+BG_HashCatalogString
+============
+*/
+static unsigned BG_HashCatalogString( const char *s ) {
+	unsigned	hash;
+
+	hash = 2166136261u;
+	while ( *s ) {
+		hash = ( hash ^ (unsigned char)tolower( *s ) ) * 16777619u;
+		s++;
+	}
+	return hash;
+}
+
+/*
+============
+BG_CatalogString
+============
+*/
+static int BG_CatalogString( modelCatalog_t *mc, const char *s ) {
+	int		len, ofs;
+
+	len = strlen( s ) + 1;
+	if ( mc->poolUsed + len > CATALOG_POOLSIZE ) {
+		return -1;
+	}
+	ofs = mc->poolUsed;
+	memcpy( mc->pool + ofs, s, len );
+	mc->poolUsed += len;
+	return ofs;
+}
+
+/*
+============
+BG_FindCatalogDir
+============
+*/
+static int BG_FindCatalogDir( modelCatalog_t *mc, const char *name ) {
+	int		i;
+
+	for ( i = mc->hashTable[BG_HashCatalogString( name ) & ( CATALOG_HASH_SIZE - 1 )] ; i ; i = mc->dirs[i-1].hashNext ) {
+		if ( !Q_stricmp( mc->pool + mc->dirs[i-1].name, name ) ) {
+			return i - 1;
+		}
+	}
+	return -1;
+}
+
+/*
+============
+BG_AddCatalogDir
+============
+*/
+static int BG_AddCatalogDir( modelCatalog_t *mc, const char *name ) {
+	catalogDir_t	*dir;
+	int		bucket;
+
+	if ( mc->numDirs >= MAX_CATALOGDIRS ) {
+		return -1;
+	}
+
+	dir = &mc->dirs[mc->numDirs];
+	dir->name = BG_CatalogString( mc, name );
+	if ( dir->name < 0 ) {
+		return -1;
+	}
+	dir->firstIcon = mc->numIcons;
+	dir->numIcons = 0;
+	dir->present = qfalse;
+
+	bucket = BG_HashCatalogString( name ) & ( CATALOG_HASH_SIZE - 1 );
+	dir->hashNext = mc->hashTable[bucket];
+	mc->hashTable[bucket] = mc->numDirs + 1;
+
+	return mc->numDirs++;
+}
+
+/*
+============
+BG_AddCatalogIcon
+
+Icons have to be added right after their directory
+============
+*/
+static void BG_AddCatalogIcon( modelCatalog_t *mc, int dirnum, const char *icon ) {
+	int		ofs;
+
+	if ( mc->numIcons >= MAX_CATALOGICONS ) {
+		return;
+	}
+	ofs = BG_CatalogString( mc, icon );
+	if ( ofs < 0 ) {
+		return;
+	}
+	mc->icons[mc->numIcons++] = ofs;
+	mc->dirs[dirnum].numIcons++;
+}
+
+/*
+============
+BG_LoadModelCatalog
+============
+*/
+static void BG_LoadModelCatalog( modelCatalog_t *mc, int pakHash, qboolean useFile ) {
+	fileHandle_t	f;
+	char			*text_p, *token;
+	int				len, dirnum, count;
+
+	mc->pakHash = pakHash;
+	mc->numDirs = 0;
+	mc->numOrder = 0;
+	mc->numIcons = 0;
+	mc->poolUsed = 0;
+	memset( mc->hashTable, 0, sizeof( mc->hashTable ) );
+	if ( !useFile ) {
+		return;
+	}
+
+	len = trap_FS_FOpenFile( MODELCATALOG_FILE, &f, FS_READ );
+	if ( !f ) {
+		return;
+	}
+	if ( len <= 0 || len >= sizeof( mc->text ) ) {
+		trap_FS_FCloseFile( f );
+		return;
+	}
+	trap_FS_Read( mc->text, len, f );
+	mc->text[len] = 0;
+	trap_FS_FCloseFile( f );
+
+	text_p = mc->text;
+	token = COM_Parse( &text_p );
+	if ( strcmp( token, MODELCATALOG_IDENT ) ) {
+		return;
+	}
+	token = COM_Parse( &text_p );
+	if ( atoi( token ) != MODELCATALOG_VERSION ) {
+		return;
+	}
+	token = COM_Parse( &text_p );
+	if ( atoi( token ) != pakHash ) {
+		// the pk3s changed, any directory might have new skins
+		return;
+	}
+
+	while ( 1 ) {
+		token = COM_Parse( &text_p );
+		if ( !token[0] ) {
+			break;
+		}
+		dirnum = BG_AddCatalogDir( mc, token );
+		if ( dirnum < 0 ) {
+			break;
+		}
+		count = atoi( COM_Parse( &text_p ) );
+		while ( count-- > 0 ) {
+			token = COM_Parse( &text_p );
+			if ( !token[0] ) {
+				break;
+			}
+			BG_AddCatalogIcon( mc, dirnum, token );
+		}
+	}
+}
+
+/*
+============
+BG_SaveModelCatalog
+============
+*/
+static void BG_SaveModelCatalog( modelCatalog_t *mc ) {
+	catalogDir_t	*dir;
+	fileHandle_t	f;
+	char			*s;
+	int				i, j;
+
+	trap_FS_FOpenFile( MODELCATALOG_FILE, &f, FS_WRITE );
+	if ( !f ) {
+		return;
+	}
+
+	s = va( "%s %i %i\n", MODELCATALOG_IDENT, MODELCATALOG_VERSION, mc->pakHash );
+	trap_FS_Write( s, strlen( s ), f );
+
+	for ( i = 0 ; i < mc->numOrder ; i++ ) {
+		dir = &mc->dirs[mc->order[i]];
+		s = va( "\"%s\" %i", BG_CatalogDirName( mc, dir ), dir->numIcons );
+		trap_FS_Write( s, strlen( s ), f );
+		for ( j = 0 ; j < dir->numIcons ; j++ ) {
+			s = va( " \"%s\"", BG_CatalogIconName( mc, dir, j ) );
+			trap_FS_Write( s, strlen( s ), f );
+		}
+		trap_FS_Write( "\n", 1, f );
+	}
+
+	trap_FS_FCloseFile( f );
+}
+
+/*
+============
+BG_ScanCatalogDir
+============
+*/
+static void BG_ScanCatalogDir( modelCatalog_t *mc, int dirnum,
+		int (*getFileList)( const char *path, const char *extension, char *listbuf, int bufsize ),
+		void (*skinListed)( const char *skinname ) ) {
+	char	filelist[4096];
+	char	skinname[MAX_QPATH];
+	char	*fileptr;
+	int		numfiles;
+	int		filelen;
+	int		j;
+
+	numfiles = getFileList( va( "models/players/%s", BG_CatalogDirName( mc, &mc->dirs[dirnum] ) ), "tga", filelist, sizeof( filelist ) );
+	fileptr = filelist;
+	for ( j = 0 ; j < numfiles ; j++, fileptr += filelen + 1 ) {
+		filelen = strlen( fileptr );
+
+		COM_StripExtension( fileptr, skinname, sizeof( skinname ) );
+
+		// look for icon_????
+		if ( !Q_stricmpn( skinname, "icon_", 5 ) ) {
+			BG_AddCatalogIcon( mc, dirnum, skinname );
+		}
+
+		if ( skinListed ) {
+			skinListed( skinname );
+		}
+	}
+}
+
+/*
+============
+BG_SyncModelCatalog
+
+Brings the catalog up to date with models/players and leaves the
+directories found there in mc->order.  With rescan the file is ignored
+and every directory is listed again.
+============
+*/
+void BG_SyncModelCatalog( modelCatalog_t *mc, qboolean rescan,
+		int (*getFileList)( const char *path, const char *extension, char *listbuf, int bufsize ),
+		void (*skinListed)( const char *skinname ) ) {
+	char		*dirptr;
+	int			numdirs;
+	int			dirlen;
+	int			dirnum;
+	int			i;
+	int			pakHash;
+	qboolean	changed;
+
+	// the catalog is only trusted for the same pk3s
+	numdirs = getFileList( "", "pk3", mc->text, sizeof( mc->text ) );
+	pakHash = numdirs;
+	dirptr = mc->text;
+	for ( i = 0 ; i < numdirs ; i++, dirptr += dirlen + 1 ) {
+		dirlen = strlen( dirptr );
+		pakHash = pakHash * 31 + (int)BG_HashCatalogString( dirptr );
+	}
+	BG_LoadModelCatalog( mc, pakHash, !rescan );
+
+	changed = qfalse;
+	mc->numOrder = 0;
+
+	// iterate directory of all player models
+	numdirs = getFileList( "models/players", "/", mc->text, sizeof( mc->text ) );
+	dirptr = mc->text;
+	for ( i = 0 ; i < numdirs ; i++, dirptr += dirlen + 1 ) {
+		dirlen = strlen( dirptr );
+
+		if ( dirlen && dirptr[dirlen-1] == '/' ) {
+			dirptr[dirlen-1] = '\0';
+		}
+
+		if ( !strcmp( dirptr, "." ) || !strcmp( dirptr, ".." ) ) {
+			continue;
+		}
+
+		dirnum = BG_FindCatalogDir( mc, dirptr );
+		if ( dirnum < 0 ) {
+			dirnum = BG_AddCatalogDir( mc, dirptr );
+			if ( dirnum < 0 ) {
+				// catalog full
+				break;
+			}
+			BG_ScanCatalogDir( mc, dirnum, getFileList, skinListed );
+			changed = qtrue;
+		}
+		if ( mc->dirs[dirnum].present ) {
+			// listed twice
+			continue;
+		}
+		mc->dirs[dirnum].present = qtrue;
+		mc->order[mc->numOrder++] = dirnum;
+	}
+
+	// directories that went away
+	if ( mc->numOrder != mc->numDirs ) {
+		changed = qtrue;
+	}
+
+	if ( changed ) {
+		BG_SaveModelCatalog( mc );
+	}
+}
@@ -817,6 +817,64 @@ qboolean	BG_PlayerTouchesItem( playerState_t *ps, entityState_t *item, int atTim
 #define MAX_BOTS			1024
 #define MAX_BOTS_TEXT		8192
 
+// arena and bot infos hashed by the value of one key ("map", "name")
+#define MAX_INDEXED_INFOS	1024		// >= MAX_ARENAS, MAX_BOTS
+#define INFO_INDEX_HASH		1024		// power of two
+#define INFO_INDEX_POOL		(32*1024)
+
+typedef struct {
+	qboolean	overflow;					// some values didn't fit, lookups have to scan
+	int			first[INFO_INDEX_HASH];		// info number + 1
+	int			next[MAX_INDEXED_INFOS];
+	int			value[MAX_INDEXED_INFOS];	// pool offset + 1, 0 if not indexed
+	int			poolUsed;
+	char		pool[INFO_INDEX_POOL];
+} infoIndex_t;
+
+void		BG_InitInfoIndex( infoIndex_t *index );
+void		BG_AddToInfoIndex( infoIndex_t *index, int num, const char *value );
+int			BG_FindInInfoIndex( const infoIndex_t *index, const char *value );
+const char	*BG_InfoIndexValue( const infoIndex_t *index, int num );
+
+// the icon_ skins of every directory under models/players, kept in a
+// file between sessions so the player model menus don't have to list
+// each directory again
+#define MAX_CATALOGDIRS			1024
+#define MAX_CATALOGICONS		4096
+#define CATALOG_POOLSIZE		65536
+#define CATALOG_HASH_SIZE		256
+
+typedef struct {
+	int			name;			// offset in the string pool
+	int			firstIcon;
+	int			numIcons;
+	qboolean	present;		// still listed under models/players
+	int			hashNext;		// dir index + 1
+} catalogDir_t;
+
+typedef struct {
+	int				pakHash;
+	int				numDirs;
+	catalogDir_t	dirs[MAX_CATALOGDIRS];
+	int				order[MAX_CATALOGDIRS];		// present dirs in listing order
+	int				numOrder;
+	int				numIcons;
+	int				icons[MAX_CATALOGICONS];	// pool offsets of the icon names
+	int				poolUsed;
+	char			pool[CATALOG_POOLSIZE];
+	int				hashTable[CATALOG_HASH_SIZE];	// dir index + 1
+	char			text[CATALOG_POOLSIZE];		// file and listing buffer while syncing
+} modelCatalog_t;
+
+#define	BG_CatalogDirName( mc, dir )		( (mc)->pool + (dir)->name )
+#define	BG_CatalogIconName( mc, dir, i )	( (mc)->pool + (mc)->icons[(dir)->firstIcon + (i)] )
+
+// getFileList is trap_FS_GetFileList, which only the ui modules have;
+// skinListed is called for every skin of a directory that gets listed
+void		BG_SyncModelCatalog( modelCatalog_t *mc, qboolean rescan,
+				int (*getFileList)( const char *path, const char *extension, char *listbuf, int bufsize ),
+				void (*skinListed)( const char *skinname ) );
+
 
 // Kamikaze
 
@@ -252,7 +252,11 @@ void	G_TouchTriggers( gentity_t *ent ) {
 	VectorSubtract( ent->client->ps.origin, range, mins );
 	VectorAdd( ent->client->ps.origin, range, maxs );
 
-	num = trap_EntitiesInBox( mins, maxs, touch, MAX_GENTITIES );
+	if ( g_triggerGrid.integer ) {
+		num = G_TriggersInBox( mins, maxs, touch, MAX_GENTITIES );
+	} else {
+		num = trap_EntitiesInBox( mins, maxs, touch, MAX_GENTITIES );
+	}
 
 	// can't use ent->absmin, because that has a one unit pad
 	VectorAdd( ent->client->ps.origin, ent->r.mins, mins );
@@ -792,7 +796,14 @@ void ClientThink_real( gentity_t *ent ) {
 	// frameOffset should be about the number of milliseconds into a frame 
 	// this command packet was received, depending on how fast the server
 	// does a G_RunFrame()
-	client->frameOffset = trap_Milliseconds() - level.frameStartTime;
+	if ( client->cmdPending ) {
+		// a coalesced command is run on the next frame, use the
+		// time the last command of it came in
+		client->frameOffset = client->cmdPendingOffset;
+		client->cmdPending = qfalse;
+	} else {
+		client->frameOffset = trap_Milliseconds() - level.frameStartTime;
+	}
 //unlagged - backward reconciliation #4
 
 
@@ -1057,6 +1068,7 @@ void ClientThink_real( gentity_t *ent ) {
 			}
 		}
         #endif
+	G_PmoveRecord( ent, &pm );
 	Pmove (&pm);
 
 	// save results of pmove
@@ -1151,6 +1163,133 @@ void ClientThink_real( gentity_t *ent ) {
 	ClientTimerActions( ent, msec );
 }
 
+/*
+==================
+ClientCanDefer
+
+True if running pers.cmd can be put off until the next frame without
+changing anything but the amount of work: the client is standing and
+using pmove_fixed, and neither the command nor the world around it can
+produce events, weapon changes, jumps or trigger touches.
+==================
+*/
+#define	COALESCE_MAX_MSEC	200		// same clamp as ClientThink_real
+
+static qboolean ClientCanDefer( gentity_t *ent ) {
+	gclient_t	*client;
+	usercmd_t	*ucmd;
+	vec3_t		mins, maxs;
+	float		pad;
+	int			touch[1];
+	int			i;
+
+	client = ent->client;
+	ucmd = &client->pers.cmd;
+
+	if ( !g_coalesceCommands.integer || !( pmove_fixed.integer || client->pers.pmoveFixed ) ) {
+		return qfalse;
+	}
+	if ( client->pers.connected != CON_CONNECTED || level.intermissiontime ) {
+		return qfalse;
+	}
+	if ( client->sess.sessionTeam == TEAM_SPECTATOR || client->isEliminated || client->noclip ) {
+		return qfalse;
+	}
+	if ( client->ps.pm_type != PM_NORMAL || client->ps.stats[STAT_HEALTH] <= 0 ) {
+		return qfalse;
+	}
+	if ( client->ps.groundEntityNum == ENTITYNUM_NONE || ent->waterlevel > 1 || client->ps.pm_time ) {
+		return qfalse;
+	}
+	if ( client->ps.weaponstate != WEAPON_READY || ucmd->weapon != client->ps.weapon || client->hook ) {
+		return qfalse;
+	}
+	if ( ( ucmd->buttons & ( BUTTON_ATTACK | BUTTON_USE_HOLDABLE | BUTTON_GESTURE ) ) || ucmd->upmove > 0 ) {
+		return qfalse;
+	}
+	if ( ent->flags & FL_FORCE_GESTURE ) {
+		return qfalse;
+	}
+	if ( ucmd->serverTime - client->ps.commandTime > COALESCE_MAX_MSEC ) {
+		return qfalse;
+	}
+
+	// nothing to touch anywhere the client can get to before it is run
+	pad = 64 + VectorLength( client->ps.velocity ) * COALESCE_MAX_MSEC * 0.001f;
+	for ( i = 0 ; i < 3 ; i++ ) {
+		mins[i] = client->ps.origin[i] + ent->r.mins[i] - pad;
+		maxs[i] = client->ps.origin[i] + ent->r.maxs[i] + pad;
+	}
+	if ( G_TriggersInBox( mins, maxs, touch, 1 ) ) {
+		return qfalse;
+	}
+
+	return qtrue;
+}
+
+/*
+==================
+ClientCoalesceCommand
+
+Merges cmd into the pending command if it only moves it forward in time.
+With pmove_fixed both commands are cut into the same pmove_msec steps,
+so one Pmove over the merged command gives the exact result the client
+predicted for the separate ones.
+==================
+*/
+static qboolean ClientCoalesceCommand( gentity_t *ent, usercmd_t *cmd ) {
+	gclient_t	*client;
+	usercmd_t	*pending;
+
+	client = ent->client;
+	pending = &client->pers.cmd;
+
+	if ( pending->buttons != cmd->buttons || pending->weapon != cmd->weapon
+		|| pending->forwardmove != cmd->forwardmove || pending->rightmove != cmd->rightmove
+		|| pending->upmove != cmd->upmove || pending->angles[0] != cmd->angles[0]
+		|| pending->angles[1] != cmd->angles[1] || pending->angles[2] != cmd->angles[2] ) {
+		return qfalse;
+	}
+	if ( cmd->serverTime - client->ps.commandTime > COALESCE_MAX_MSEC ) {
+		return qfalse;
+	}
+
+	pending->serverTime = cmd->serverTime;
+	client->cmdPendingOffset = trap_Milliseconds() - level.frameStartTime;
+	return qtrue;
+}
+
+/*
+==================
+ClientFlushCommand
+==================
+*/
+static void ClientFlushCommand( gentity_t *ent ) {
+	if ( !ent->client->cmdPending ) {
+		return;
+	}
+	ClientThink_real( ent );
+	ent->client->cmdPending = qfalse;
+}
+
+/*
+==================
+G_FlushClientCommands
+
+Runs every command held back by g_coalesceCommands, called at the start
+of G_RunFrame before level.time advances
+==================
+*/
+void G_FlushClientCommands( void ) {
+	int		i;
+
+	for ( i = 0 ; i < level.maxclients ; i++ ) {
+		if ( level.clients[i].cmdPending ) {
+			ClientFlushCommand( g_entities + i );
+		}
+	}
+}
+
 /*
 ==================
 ClientThink
@@ -1160,9 +1299,18 @@ A new command has arrived from the client
 */
 void ClientThink( int clientNum ) {
 	gentity_t *ent;
+	usercmd_t	cmd;
 
 	ent = g_entities + clientNum;
-	trap_GetUsercmd( clientNum, &ent->client->pers.cmd );
+	trap_GetUsercmd( clientNum, &cmd );
+
+	if ( ent->client->cmdPending ) {
+		if ( ClientCoalesceCommand( ent, &cmd ) ) {
+			return;
+		}
+		ClientFlushCommand( ent );
+	}
+	ent->client->pers.cmd = cmd;
 
 	//Unlagged: commented out
 	// mark the time we got info, so we can display the
@@ -1170,6 +1318,11 @@ void ClientThink( int clientNum ) {
 	//ent->client->lastCmdTime = level.time;
 
 	if ( !(ent->r.svFlags & SVF_BOT) && !g_synchronousClients.integer ) {
+		if ( ClientCanDefer( ent ) ) {
+			ent->client->cmdPending = qtrue;
+			ent->client->cmdPendingOffset = trap_Milliseconds() - level.frameStartTime;
+			return;
+		}
 		ClientThink_real( ent );
 	}
 }
@@ -844,7 +844,7 @@ void G_admin_duration( int secs, char *duration, int dursize )
     Com_sprintf( duration, dursize, "%i seconds", secs );
 }
 
-qboolean G_admin_ban_check( char *userinfo, char *reason, int rlen )
+qboolean G_admin_ban_check( infoView_t *userinfo, char *reason, int rlen )
 {
   char *guid, *ip;
   int i;
@@ -852,12 +852,10 @@ qboolean G_admin_ban_check( char *userinfo, char *reason, int rlen )
 
   *reason = '\0';
   t = trap_RealTime( NULL );
-  if( !*userinfo )
-    return qfalse;
-  ip = Info_ValueForKey( userinfo, "ip" );
+  ip = Info_ViewValue( userinfo, "ip" );
   if( !*ip )
     return qfalse;
-  guid = Info_ValueForKey( userinfo, "cl_guid" );
+  guid = Info_ViewValue( userinfo, "cl_guid" );
   for( i = 0; i < MAX_ADMIN_BANS && g_admin_bans[ i ]; i++ )
   {
     // 0 is for perm ban
@@ -27,10 +27,12 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 static int		g_numBots;
 static char		*g_botInfos[MAX_BOTS];
+static infoIndex_t	g_botIndex;		// by name
 
 
 int				g_numArenas;
 static char		*g_arenaInfos[MAX_ARENAS];
+static infoIndex_t	g_arenaIndex;	// by map
 
 
 #define BOT_BEGIN_DELAY_BASE		2000
@@ -160,7 +162,7 @@ static void G_LoadArenas( void ) {
 	int			numdirs;
 	vmCvar_t	arenasFile;
 	char		filename[128];
-	char		dirlist[1024];
+	static char	dirlist[20*1024];
 	char*		dirptr;
 	int			i, n;
 	int			dirlen;
@@ -176,7 +178,7 @@ static void G_LoadArenas( void ) {
 	}
 
 	// get all arenas from .arena files
-	numdirs = trap_FS_GetFileList("scripts", ".arena", dirlist, 1024 );
+	numdirs = trap_FS_GetFileList("scripts", ".arena", dirlist, sizeof(dirlist) );
 	dirptr  = dirlist;
 	for (i = 0; i < numdirs; i++, dirptr += dirlen+1) {
 		dirlen = strlen(dirptr);
@@ -186,8 +188,10 @@ static void G_LoadArenas( void ) {
 	}
 	trap_Printf( va( "%i arenas parsed\n", g_numArenas ) );
 	
+	BG_InitInfoIndex( &g_arenaIndex );
 	for( n = 0; n < g_numArenas; n++ ) {
 		Info_SetValueForKey( g_arenaInfos[n], "num", va( "%i", n ) );
+		BG_AddToInfoIndex( &g_arenaIndex, n, Info_ValueForKey( g_arenaInfos[n], "map" ) );
 	}
 }
 
@@ -200,6 +204,14 @@ G_GetArenaInfoByNumber
 const char *G_GetArenaInfoByMap( const char *map ) {
 	int			n;
 
+	n = BG_FindInInfoIndex( &g_arenaIndex, map );
+	if( n >= 0 ) {
+		return g_arenaInfos[n];
+	}
+	if( !g_arenaIndex.overflow ) {
+		return NULL;
+	}
+
 	for( n = 0; n < g_numArenas; n++ ) {
 		if( Q_stricmp( Info_ValueForKey( g_arenaInfos[n], "map" ), map ) == 0 ) {
 			return g_arenaInfos[n];
@@ -235,6 +247,21 @@ static void PlayerIntroSound( const char *modelAndSkin ) {
 	trap_SendConsoleCommand( EXEC_APPEND, va( "play sound/player/announce/%s.wav\n", skin ) );
 }
 
+/*
+===============
+G_BotName
+===============
+*/
+static const char *G_BotName( int num ) {
+	const char	*name;
+
+	name = BG_InfoIndexValue( &g_botIndex, num );
+	if ( !name ) {
+		name = Info_ValueForKey( g_botInfos[num], "name" );
+	}
+	return name;
+}
+
 /*
 ===============
 G_AddRandomBot
@@ -243,7 +270,8 @@ G_AddRandomBot
 void G_AddRandomBot( int team ) {
 	int		i, n, num;
 	float	skill;
-	char	*value, netname[36], *teamstr;
+	const char	*value;
+	char	netname[36], *teamstr;
 	gclient_t	*cl;
 
         if (!trap_AAS_Initialized())
@@ -251,7 +279,7 @@ void G_AddRandomBot( int team ) {
 
 	num = 0;
 	for ( n = 0; n < g_numBots ; n++ ) {
-		value = Info_ValueForKey( g_botInfos[n], "name" );
+		value = G_BotName( n );
 		//
 		for ( i=0 ; i< g_maxclients.integer ; i++ ) {
 			cl = level.clients + i;
@@ -274,7 +302,7 @@ void G_AddRandomBot( int team ) {
 	}
 	num = random() * num;
 	for ( n = 0; n < g_numBots ; n++ ) {
-		value = Info_ValueForKey( g_botInfos[n], "name" );
+		value = G_BotName( n );
 		//
 		for ( i=0 ; i< g_maxclients.integer ; i++ ) {
 			cl = level.clients + i;
@@ -903,7 +931,7 @@ static void G_LoadBots( void ) {
 	vmCvar_t	botsFile;
 	int			numdirs;
 	char		filename[128];
-	char		dirlist[1024];
+	static char	dirlist[20*1024];
 	char*		dirptr;
 	int			i;
 	int			dirlen;
@@ -923,7 +951,7 @@ static void G_LoadBots( void ) {
 	}
 
 	// get all bots from .bot files
-	numdirs = trap_FS_GetFileList("scripts", ".bot", dirlist, 1024 );
+	numdirs = trap_FS_GetFileList("scripts", ".bot", dirlist, sizeof(dirlist) );
 	dirptr  = dirlist;
 	for (i = 0; i < numdirs; i++, dirptr += dirlen+1) {
 		dirlen = strlen(dirptr);
@@ -932,6 +960,11 @@ static void G_LoadBots( void ) {
 		G_LoadBotsFromFile(filename);
 	}
 	trap_Printf( va( "%i bots parsed\n", g_numBots ) );
+
+	BG_InitInfoIndex( &g_botIndex );
+	for( i = 0; i < g_numBots; i++ ) {
+		BG_AddToInfoIndex( &g_botIndex, i, Info_ValueForKey( g_botInfos[i], "name" ) );
+	}
 }
 
 
@@ -959,6 +992,14 @@ char *G_GetBotInfoByName( const char *name ) {
 	int		n;
 	char	*value;
 
+	n = BG_FindInInfoIndex( &g_botIndex, name );
+	if ( n >= 0 ) {
+		return g_botInfos[n];
+	}
+	if ( !g_botIndex.overflow ) {
+		return NULL;
+	}
+
 	for ( n = 0; n < g_numBots ; n++ ) {
 		value = Info_ValueForKey( g_botInfos[n], "name" );
 		if ( !Q_stricmp( value, name ) ) {
@@ -86,30 +86,164 @@ void SP_info_player_intermission( gentity_t *ent ) {
 
 /*
 ================
-SpotWouldTelefrag
+G_ClearSpawnPoints
 
+Spawn point lists are built the first time each classname is asked
+for after the level has spawned, and kept in entity order so the
+selection functions pick exactly what their G_Find loops used to.
 ================
 */
-qboolean SpotWouldTelefrag( gentity_t *spot ) {
-	int			i, num;
-	int			touch[MAX_GENTITIES];
-	gentity_t	*hit;
-	vec3_t		mins, maxs;
+#define	MAX_SPAWN_LISTS		8
+#define	MAX_SPAWN_POINTS	128
+
+typedef struct {
+	const char	*classname;
+	int			numSpots;
+	gentity_t	*spots[MAX_SPAWN_POINTS];
+} spawnList_t;
+
+static spawnList_t	spawnLists[MAX_SPAWN_LISTS];
+static int			numSpawnLists;
+
+void G_ClearSpawnPoints( void ) {
+	numSpawnLists = 0;
+}
+
+/*
+================
+G_SpawnPoints
+================
+*/
+static spawnList_t *G_SpawnPoints( const char *classname ) {
+	static spawnList_t	scratch;
+	spawnList_t	*list;
+	gentity_t	*spot;
+	int			i;
+
+	for ( i = 0 ; i < numSpawnLists ; i++ ) {
+		if ( !strcmp( spawnLists[i].classname, classname ) ) {
+			return &spawnLists[i];
+		}
+	}
+
+	// don't keep a list that more entities could still be added to
+	if ( level.spawning || numSpawnLists == MAX_SPAWN_LISTS ) {
+		list = &scratch;
+	} else {
+		list = &spawnLists[numSpawnLists++];
+	}
+
+	list->classname = classname;
+	list->numSpots = 0;
+	spot = NULL;
+	while ( ( spot = G_Find( spot, FOFS(classname), classname ) ) != NULL ) {
+		if ( list->numSpots == MAX_SPAWN_POINTS ) {
+			G_Printf( "G_SpawnPoints: more than %i %s\n", MAX_SPAWN_POINTS, classname );
+			break;
+		}
+		list->spots[list->numSpots++] = spot;
+	}
+
+	return list;
+}
+
+/*
+================
+G_SpawnOccupants
+
+Bounds of everything that can be telefragged, gathered once so a whole
+spawn list can be checked without a trap_EntitiesInBox per spot
+================
+*/
+typedef struct {
+	int		numBoxes;
+	vec3_t	absmin[MAX_CLIENTS];
+	vec3_t	absmax[MAX_CLIENTS];
+} spawnOccupants_t;
+
+static void G_SpawnOccupants( spawnOccupants_t *occ ) {
+	gentity_t	*ent;
+	int			i;
+
+	occ->numBoxes = 0;
+	for ( i = 0, ent = g_entities ; i < level.maxclients ; i++, ent++ ) {
+		if ( !ent->r.linked || !ent->client ) {
+			continue;
+		}
+		VectorCopy( ent->r.absmin, occ->absmin[occ->numBoxes] );
+		VectorCopy( ent->r.absmax, occ->absmax[occ->numBoxes] );
+		occ->numBoxes++;
+	}
+}
+
+/*
+================
+G_SpotOccupied
+================
+*/
+static qboolean G_SpotOccupied( const spawnOccupants_t *occ, gentity_t *spot ) {
+	vec3_t	mins, maxs;
+	int		i;
 
 	VectorAdd( spot->s.origin, playerMins, mins );
 	VectorAdd( spot->s.origin, playerMaxs, maxs );
-	num = trap_EntitiesInBox( mins, maxs, touch, MAX_GENTITIES );
 
-	for (i=0 ; i<num ; i++) {
-		hit = &g_entities[touch[i]];
-		//if ( hit->client && hit->client->ps.stats[STAT_HEALTH] > 0 ) {
-		if ( hit->client) {
-			return qtrue;
+	for ( i = 0 ; i < occ->numBoxes ; i++ ) {
+		if ( occ->absmin[i][0] > maxs[0] || occ->absmin[i][1] > maxs[1] || occ->absmin[i][2] > maxs[2]
+			|| occ->absmax[i][0] < mins[0] || occ->absmax[i][1] < mins[1] || occ->absmax[i][2] < mins[2] ) {
+			continue;
+		}
+		return qtrue;
+	}
+	return qfalse;
+}
+
+/*
+================
+SpotWouldTelefrag
+
+================
+*/
+qboolean SpotWouldTelefrag( gentity_t *spot ) {
+	spawnOccupants_t	occ;
+
+	G_SpawnOccupants( &occ );
+	return G_SpotOccupied( &occ, spot );
+}
+
+/*
+================
+G_SelectFreeSpawnPoint
+
+Random spot of classname that doesn't telefrag, choosing among the
+first maxCount free ones.  Falls back to the first spot when they are
+all occupied, and returns NULL if there are none.
+================
+*/
+gentity_t *G_SelectFreeSpawnPoint( const char *classname, int maxCount ) {
+	spawnOccupants_t	occ;
+	spawnList_t	*list;
+	gentity_t	*spots[MAX_SPAWN_POINTS];
+	int			i, count;
+
+	list = G_SpawnPoints( classname );
+	if ( !list->numSpots ) {
+		return NULL;
+	}
+
+	G_SpawnOccupants( &occ );
+	count = 0;
+	for ( i = 0 ; i < list->numSpots && count < maxCount ; i++ ) {
+		if ( !G_SpotOccupied( &occ, list->spots[i] ) ) {
+			spots[count++] = list->spots[i];
 		}
+	}
 
+	if ( !count ) {	// no spots that won't telefrag
+		return list->spots[0];
 	}
 
-	return qfalse;
+	return spots[ rand() % count ];
 }
 
 /*
@@ -119,24 +253,23 @@ SelectNearestDeathmatchSpawnPoint
 Find the spot that we DON'T want to use
 ================
 */
-#define	MAX_SPAWN_POINTS	128
 gentity_t *SelectNearestDeathmatchSpawnPoint( vec3_t from ) {
-	gentity_t	*spot;
+	spawnList_t	*list;
 	vec3_t		delta;
 	float		dist, nearestDist;
 	gentity_t	*nearestSpot;
+	int			i;
 
 	nearestDist = 999999;
 	nearestSpot = NULL;
-	spot = NULL;
-
-	while ((spot = G_Find (spot, FOFS(classname), "info_player_deathmatch")) != NULL) {
 
-		VectorSubtract( spot->s.origin, from, delta );
+	list = G_SpawnPoints( "info_player_deathmatch" );
+	for ( i = 0 ; i < list->numSpots ; i++ ) {
+		VectorSubtract( list->spots[i]->s.origin, from, delta );
 		dist = VectorLength( delta );
 		if ( dist < nearestDist ) {
 			nearestDist = dist;
-			nearestSpot = spot;
+			nearestSpot = list->spots[i];
 		}
 	}
 
@@ -151,30 +284,8 @@ SelectRandomDeathmatchSpawnPoint
 go to a random point that doesn't telefrag
 ================
 */
-#define	MAX_SPAWN_POINTS	128
 gentity_t *SelectRandomDeathmatchSpawnPoint( void ) {
-	gentity_t	*spot;
-	int			count;
-	int			selection;
-	gentity_t	*spots[MAX_SPAWN_POINTS];
-
-	count = 0;
-	spot = NULL;
-
-	while ((spot = G_Find (spot, FOFS(classname), "info_player_deathmatch")) != NULL) {
-		if ( SpotWouldTelefrag( spot ) ) {
-			continue;
-		}
-		spots[ count ] = spot;
-		count++;
-	}
-
-	if ( !count ) {	// no spots that won't telefrag
-		return G_Find( NULL, FOFS(classname), "info_player_deathmatch");
-	}
-
-	selection = rand() % count;
-	return spots[ selection ];
+	return G_SelectFreeSpawnPoint( "info_player_deathmatch", MAX_SPAWN_POINTS );
 }
 
 /*
@@ -184,63 +295,68 @@ SelectRandomFurthestSpawnPoint
 Chooses a player start, deathmatch start, etc
 ============
 */
+typedef struct {
+	float		dist;
+	int			order;
+	gentity_t	*spot;
+} spotDist_t;
+
+static int QDECL SortSpotsFurthest( const void *a, const void *b ) {
+	const spotDist_t	*sa = a, *sb = b;
+
+	if ( sa->dist != sb->dist ) {
+		return sa->dist > sb->dist ? -1 : 1;
+	}
+	return sa->order - sb->order;
+}
+
 gentity_t *SelectRandomFurthestSpawnPoint ( vec3_t avoidPoint, vec3_t origin, vec3_t angles ) {
+	spawnOccupants_t	occ;
+	spawnList_t	*list;
 	gentity_t	*spot;
 	vec3_t		delta;
-	float		dist;
-	float		list_dist[64];
-	gentity_t	*list_spot[64];
-	int			numSpots, rnd, i, j;
+	spotDist_t	spots[MAX_SPAWN_POINTS];
+	int			numSpots, rnd, i;
 
-	numSpots = 0;
-	spot = NULL;
+	list = G_SpawnPoints( "info_player_deathmatch" );
+	G_SpawnOccupants( &occ );
 
-	while ((spot = G_Find (spot, FOFS(classname), "info_player_deathmatch")) != NULL) {
-		if ( SpotWouldTelefrag( spot ) ) {
+	numSpots = 0;
+	for ( i = 0 ; i < list->numSpots ; i++ ) {
+		spot = list->spots[i];
+		if ( G_SpotOccupied( &occ, spot ) ) {
 			continue;
 		}
 		VectorSubtract( spot->s.origin, avoidPoint, delta );
-		dist = VectorLength( delta );
-		for (i = 0; i < numSpots; i++) {
-			if ( dist > list_dist[i] ) {
-				if ( numSpots >= 64 )
-					numSpots = 64-1;
-				for (j = numSpots; j > i; j--) {
-					list_dist[j] = list_dist[j-1];
-					list_spot[j] = list_spot[j-1];
-				}
-				list_dist[i] = dist;
-				list_spot[i] = spot;
-				numSpots++;
-				if (numSpots > 64)
-					numSpots = 64;
-				break;
-			}
-		}
-		if (i >= numSpots && numSpots < 64) {
-			list_dist[numSpots] = dist;
-			list_spot[numSpots] = spot;
-			numSpots++;
-		}
+		spots[numSpots].dist = VectorLength( delta );
+		spots[numSpots].order = numSpots;
+		spots[numSpots].spot = spot;
+		numSpots++;
 	}
+
 	if (!numSpots) {
-		spot = G_Find( NULL, FOFS(classname), "info_player_deathmatch");
-		if (!spot)
+		if ( !list->numSpots )
 			G_Error( "Couldn't find a spawn point" );
+		spot = list->spots[0];
 		VectorCopy (spot->s.origin, origin);
 		origin[2] += 9;
 		VectorCopy (spot->s.angles, angles);
 		return spot;
 	}
 
+	// furthest first, earlier spots first among equals, only the 64 furthest count
+	qsort( spots, numSpots, sizeof( spots[0] ), SortSpotsFurthest );
+	if ( numSpots > 64 )
+		numSpots = 64;
+
 	// select a random spot from the spawn points furthest away
 	rnd = random() * (numSpots / 2);
 
-	VectorCopy (list_spot[rnd]->s.origin, origin);
+	VectorCopy (spots[rnd].spot->s.origin, origin);
 	origin[2] += 9;
-	VectorCopy (list_spot[rnd]->s.angles, angles);
+	VectorCopy (spots[rnd].spot->s.angles, angles);
 
-	return list_spot[rnd];
+	return spots[rnd].spot;
 }
 
 /*
@@ -290,11 +406,15 @@ use normal spawn selection.
 ============
 */
 gentity_t *SelectInitialSpawnPoint( vec3_t origin, vec3_t angles ) {
+	spawnList_t	*list;
 	gentity_t	*spot;
+	int			i;
 
 	spot = NULL;
-	while ((spot = G_Find (spot, FOFS(classname), "info_player_deathmatch")) != NULL) {
-		if ( spot->spawnflags & 1 ) {
+	list = G_SpawnPoints( "info_player_deathmatch" );
+	for ( i = 0 ; i < list->numSpots ; i++ ) {
+		if ( list->spots[i]->spawnflags & 1 ) {
+			spot = list->spots[i];
 			break;
 		}
 	}
@@ -1114,6 +1234,7 @@ void ClientUserinfoChanged( int clientNum ) {
 	char	redTeam[MAX_INFO_STRING];
 	char	blueTeam[MAX_INFO_STRING];
 	char	userinfo[MAX_INFO_STRING];
+	infoView_t	info;
 
 	ent = g_entities + clientNum;
 	client = ent->client;
@@ -1124,15 +1245,16 @@ void ClientUserinfoChanged( int clientNum ) {
 	if ( !Info_Validate(userinfo) ) {
 		strcpy (userinfo, "\\name\\badinfo");
 	}
+	Info_Parse( &info, userinfo );
 
 	// check for local client
-	s = Info_ValueForKey( userinfo, "ip" );
+	s = Info_ViewValue( &info, "ip" );
 	if ( !strcmp( s, "localhost" ) ) {
 		client->pers.localClient = qtrue;
 	}
 
 	// check the item prediction
-	s = Info_ValueForKey( userinfo, "cg_predictItems" );
+	s = Info_ViewValue( &info, "cg_predictItems" );
 	if ( !atoi( s ) ) {
 		client->pers.predictItemPickup = qfalse;
 	} else {
@@ -1141,7 +1263,7 @@ void ClientUserinfoChanged( int clientNum ) {
 
 //unlagged - client options
 	// see if the player has opted out
-	s = Info_ValueForKey( userinfo, "cg_delag" );
+	s = Info_ViewValue( &info, "cg_delag" );
 	if ( !atoi( s ) ) {
 		client->pers.delag = 0;
 	} else {
@@ -1149,11 +1271,11 @@ void ClientUserinfoChanged( int clientNum ) {
 	}
 
 	// see if the player is nudging his shots
-	s = Info_ValueForKey( userinfo, "cg_cmdTimeNudge" );
+	s = Info_ViewValue( &info, "cg_cmdTimeNudge" );
 	client->pers.cmdTimeNudge = atoi( s );
 
 	// see if the player wants to debug the backward reconciliation
-	/*s = Info_ValueForKey( userinfo, "cg_debugDelag" );
+	/*s = Info_ViewValue( &info, "cg_debugDelag" );
 	if ( !atoi( s ) ) {
 		client->pers.debugDelag = qfalse;
 	}
@@ -1176,7 +1298,7 @@ void ClientUserinfoChanged( int clientNum ) {
 
 	// set name
 	Q_strncpyz ( oldname, client->pers.netname, sizeof( oldname ) );
-	s = Info_ValueForKey (userinfo, "name");
+	s = Info_ViewValue( &info, "name");
 	ClientCleanName( s, client->pers.netname, sizeof(client->pers.netname), clientNum );
 
     //KK-OAPub Added From Tremulous-Control Name Changes
@@ -1221,6 +1343,7 @@ void ClientUserinfoChanged( int clientNum ) {
                 sizeof( client->pers.netname ) );
             Info_SetValueForKey( userinfo, "name", oldname );
             trap_SetUserinfo( clientNum, userinfo );
+            Info_Parse( &info, userinfo );
         }
         else
         {
@@ -1257,7 +1380,7 @@ void ClientUserinfoChanged( int clientNum ) {
 	if (client->ps.powerups[PW_GUARD]) {
 		client->pers.maxHealth = 200;
 	} else {
-		health = atoi( Info_ValueForKey( userinfo, "handicap" ) );
+		health = atoi( Info_ViewValue( &info, "handicap" ) );
 		client->pers.maxHealth = health;
 		if ( client->pers.maxHealth < 1 || client->pers.maxHealth > 100 ) {
 			client->pers.maxHealth = 100;
@@ -1267,16 +1390,16 @@ void ClientUserinfoChanged( int clientNum ) {
 
 	// set model
 	if( g_gametype.integer >= GT_TEAM && g_ffa_gt==0) {
-		Q_strncpyz( model, Info_ValueForKey (userinfo, "team_model"), sizeof( model ) );
-		Q_strncpyz( headModel, Info_ValueForKey (userinfo, "team_headmodel"), sizeof( headModel ) );
+		Q_strncpyz( model, Info_ViewValue( &info, "team_model"), sizeof( model ) );
+		Q_strncpyz( headModel, Info_ViewValue( &info, "team_headmodel"), sizeof( headModel ) );
 	} else {
-		Q_strncpyz( model, Info_ValueForKey (userinfo, "model"), sizeof( model ) );
-		Q_strncpyz( headModel, Info_ValueForKey (userinfo, "headmodel"), sizeof( headModel ) );
+		Q_strncpyz( model, Info_ViewValue( &info, "model"), sizeof( model ) );
+		Q_strncpyz( headModel, Info_ViewValue( &info, "headmodel"), sizeof( headModel ) );
 	}
 
 	// bots set their team a few frames later
 	if (g_gametype.integer >= GT_TEAM && g_ffa_gt==0 && g_entities[clientNum].r.svFlags & SVF_BOT) {
-		s = Info_ValueForKey( userinfo, "team" );
+		s = Info_ViewValue( &info, "team" );
 		if ( !Q_stricmp( s, "red" ) || !Q_stricmp( s, "r" ) ) {
 			team = TEAM_RED;
 		} else if ( !Q_stricmp( s, "blue" ) || !Q_stricmp( s, "b" ) ) {
@@ -1316,7 +1439,7 @@ Sago: I am not happy with this exception
 	if (g_gametype.integer >= GT_TEAM && g_ffa_gt!=1) {
 		client->pers.teamInfo = qtrue;
 	} else {
-		s = Info_ValueForKey( userinfo, "teamoverlay" );
+		s = Info_ViewValue( &info, "teamoverlay" );
 		if ( ! *s || atoi( s ) != 0 ) {
 			client->pers.teamInfo = qtrue;
 		} else {
@@ -1324,7 +1447,7 @@ Sago: I am not happy with this exception
 		}
 	}
 	/*
-	s = Info_ValueForKey( userinfo, "cg_pmove_fixed" );
+	s = Info_ViewValue( &info, "cg_pmove_fixed" );
 	if ( !*s || atoi( s ) == 0 ) {
 		client->pers.pmoveFixed = qfalse;
 	}
@@ -1334,7 +1457,7 @@ Sago: I am not happy with this exception
 	*/
 
 	// team task (0 = none, 1 = offence, 2 = defence)
-	teamTask = atoi(Info_ValueForKey(userinfo, "teamtask"));
+	teamTask = atoi(Info_ViewValue( &info, "teamtask"));
 	// team Leader (1 = leader, 0 is normal player)
 	teamLeader = client->sess.teamLeader;
 
@@ -1357,12 +1480,12 @@ Sago: I am not happy with this exception
                     break;
             }
         } else {
-            strcpy(c1, Info_ValueForKey( userinfo, "color1" ));
-            strcpy(c2, Info_ValueForKey( userinfo, "color2" ));
+            strcpy(c1, Info_ViewValue( &info, "color1" ));
+            strcpy(c2, Info_ViewValue( &info, "color2" ));
         }
 
-	strcpy(redTeam, Info_ValueForKey( userinfo, "g_redteam" ));
-	strcpy(blueTeam, Info_ValueForKey( userinfo, "g_blueteam" ));
+	strcpy(redTeam, Info_ViewValue( &info, "g_redteam" ));
+	strcpy(blueTeam, Info_ViewValue( &info, "g_blueteam" ));
 
 	// send over a subset of the userinfo keys so other clients can
 	// print scoreboards, display models, and play custom sounds
@@ -1370,7 +1493,7 @@ Sago: I am not happy with this exception
 		s = va("n\\%s\\t\\%i\\model\\%s\\hmodel\\%s\\c1\\%s\\c2\\%s\\hc\\%i\\w\\%i\\l\\%i\\skill\\%s\\tt\\%d\\tl\\%d",
 			client->pers.netname, team, model, headModel, c1, c2, 
 			client->pers.maxHealth, client->sess.wins, client->sess.losses,
-			Info_ValueForKey( userinfo, "skill" ), teamTask, teamLeader );
+			Info_ViewValue( &info, "skill" ), teamTask, teamLeader );
 	} else {
 		s = va("n\\%s\\t\\%i\\model\\%s\\hmodel\\%s\\g_redteam\\%s\\g_blueteam\\%s\\c1\\%s\\c2\\%s\\hc\\%i\\w\\%i\\l\\%i\\tt\\%d\\tl\\%d",
 			client->pers.netname, client->sess.sessionTeam, model, headModel, redTeam, blueTeam, c1, c2, 
@@ -1380,7 +1503,7 @@ Sago: I am not happy with this exception
 	trap_SetConfigstring( CS_PLAYERS+clientNum, s );
 
 	// this is not the userinfo, more like the configstring actually
-	G_LogPrintf( "ClientUserinfoChanged: %i %s\\id\\%s\n", clientNum, s, Info_ValueForKey(userinfo, "cl_guid") );
+	G_LogPrintf( "ClientUserinfoChanged: %i %s\\id\\%s\n", clientNum, s, Info_ViewValue( &info, "cl_guid") );
 }
 
 
@@ -1409,6 +1532,7 @@ char *ClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
 //	char		*areabits;
 	gclient_t	*client;
 	char		userinfo[MAX_INFO_STRING];
+	infoView_t	info;
 	gentity_t	*ent;
 	char        reason[ MAX_STRING_CHARS ] = {""};
 	int         i;
@@ -1420,8 +1544,9 @@ char *ClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
 	memset( client, 0, sizeof(*client) );
 
 	trap_GetUserinfo( clientNum, userinfo, sizeof( userinfo ) );
+	Info_Parse( &info, userinfo );
 
- 	value = Info_ValueForKey( userinfo, "cl_guid" );
+ 	value = Info_ViewValue( &info, "cl_guid" );
  	Q_strncpyz( client->pers.guid, value, sizeof( client->pers.guid ) );
  	
 
@@ -1429,7 +1554,7 @@ char *ClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
  	// https://zerowing.idsoftware.com/bugzilla/show_bug.cgi?id=500
  	// recommanding PB based IP / GUID banning, the builtin system is pretty limited
  	// check to see if they are on the banned IP list
-	value = Info_ValueForKey (userinfo, "ip");
+	value = Info_ViewValue( &info, "ip");
 	Q_strncpyz( client->pers.ip, value, sizeof( client->pers.ip ) );
 	
 	if ( G_FilterPacket( value ) && !Q_stricmp(value,"localhost") ) {
@@ -1437,7 +1562,7 @@ char *ClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
 		return "You are banned from this server.";
 	}
 	
-    if( G_admin_ban_check( userinfo, reason, sizeof( reason ) ) ) {    
+    if( G_admin_ban_check( &info, reason, sizeof( reason ) ) ) {    
  	    return va( "%s", reason );
  	}
  	 
@@ -1447,7 +1572,7 @@ char *ClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
   //   this means this client is not running in our current process
 	if ( !isBot && (strcmp(value, "localhost") != 0)) {
 		// check for a password
-		value = Info_ValueForKey (userinfo, "password");
+		value = Info_ViewValue( &info, "password");
 		if ( g_password.string[0] && Q_stricmp( g_password.string, "none" ) &&
 			strcmp( g_password.string, value) != 0) {
 			return "Invalid password";
@@ -1901,6 +2026,7 @@ void ClientSpawn(gentity_t *ent) {
 	ent->takedamage = qtrue;
 	ent->inuse = qtrue;
 	ent->classname = "player";
+	G_ReindexEntity( ent );
 	ent->r.contents = CONTENTS_BODY;
 	ent->clipmask = MASK_PLAYERSOLID;
 	ent->die = player_die;
@@ -2115,6 +2241,8 @@ void ClientDisconnect( int clientNum ) {
 	// hasn't spawned yet
 	G_RemoveQueuedBotBegin( clientNum );
 
+	G_PmoveRecordStop( clientNum );
+
 	ent = g_entities + clientNum;
 	if ( !ent->client ) {
 		return;
@@ -2201,6 +2329,7 @@ void ClientDisconnect( int clientNum ) {
 	ent->s.modelindex = 0;
 	ent->inuse = qfalse;
 	ent->classname = "disconnected";
+	G_ReindexEntity( ent );
 	ent->client->pers.connected = CON_DISCONNECTED;
 	ent->client->ps.persistant[PERS_TEAM] = TEAM_FREE;
 	ent->client->sess.sessionTeam = TEAM_FREE;
@@ -182,6 +182,8 @@ struct gentity_s {
 	float		random;
 
 	gitem_t		*item;			// for bonus items
+
+	int			delagMsec;		// how far a missile was fast-forwarded when fired
 };
 
 
@@ -419,6 +421,11 @@ struct gclient_s {
 	// the last frame number we got an update from this client
 	int			lastUpdateFrame;
 //unlagged - smooth clients #1
+
+	// g_coalesceCommands: pers.cmd holds a deferred command that
+	// ClientThink_real has not run yet
+	qboolean	cmdPending;
+	int			cmdPendingOffset;	// frameOffset when it arrived
         qboolean        spawnprotected;
 
         int			accuracy[WP_NUM_WEAPONS][2];
@@ -647,6 +654,9 @@ int		G_SoundIndex( char *name );
 void	G_TeamCommand( team_t team, char *cmd );
 void	G_KillBox (gentity_t *ent);
 gentity_t *G_Find (gentity_t *from, int fieldofs, const char *match);
+void	G_InitEntityIndex( void );
+void	G_ReindexEntity( gentity_t *ent );
+void	G_SyncEntityIndex( void );
 gentity_t *G_PickTarget (char *targetname);
 void	G_UseTargets (gentity_t *ent, gentity_t *activator);
 void	G_SetMovedir ( vec3_t angles, vec3_t movedir);
@@ -699,6 +709,7 @@ void TossClientCubes( gentity_t *self );
 // g_missile.c
 //
 void G_RunMissile( gentity_t *ent );
+void G_DelagMissile( gentity_t *ent, gentity_t *missile );
 void ProximityMine_RemoveAll( void );
 
 gentity_t *fire_blaster (gentity_t *self, vec3_t start, vec3_t aimdir);
@@ -716,11 +727,18 @@ gentity_t *fire_prox( gentity_t *self, vec3_t start, vec3_t aimdir );
 //
 void G_RunMover( gentity_t *ent );
 void Touch_DoorTrigger( gentity_t *ent, gentity_t *other, trace_t *trace );
+void G_InitPushables( void );
+void G_RefilePushable( gentity_t *ent );
+void G_SyncPushables( void );
 
 //
 // g_trigger.c
 //
 void trigger_teleporter_touch (gentity_t *self, gentity_t *other, trace_t *trace );
+void G_InitTriggerGrid( void );
+void G_RefileTrigger( gentity_t *ent );
+void G_SyncTriggerGrid( void );
+int G_TriggersInBox( const vec3_t mins, const vec3_t maxs, int *list, int maxcount );
 
 
 //
@@ -783,6 +801,8 @@ void player_die (gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int
 void AddScore( gentity_t *ent, vec3_t origin, int score );
 void CalculateRanks( void );
 qboolean SpotWouldTelefrag( gentity_t *spot );
+void G_ClearSpawnPoints( void );
+gentity_t *G_SelectFreeSpawnPoint( const char *classname, int maxCount );
 
 //
 // g_svcmds.c
@@ -863,6 +883,7 @@ void ClientCommand( int clientNum );
 void ClientThink( int clientNum );
 void ClientEndFrame( gentity_t *ent );
 void G_RunClient( gentity_t *ent );
+void G_FlushClientCommands( void );
 
 //
 // g_team.c
@@ -922,6 +943,13 @@ void PlayerStoreInit( void );
 void PlayerStore_store(char* guid, playerState_t ps);
 void PlayerStore_restore(char* guid, playerState_t *ps);
 
+//
+// g_pmoverecord.c
+//
+void G_PmoveRecord( gentity_t *ent, pmove_t *pm );
+void G_PmoveRecordStop( int clientNum );
+void Svcmd_PmoveRecord_f( void );
+
 //
 // g_vote.c
 //
@@ -1038,6 +1066,8 @@ extern	vmCvar_t	g_obeliskRegenAmount;
 extern	vmCvar_t	g_obeliskRespawnDelay;
 extern	vmCvar_t	g_cubeTimeout;
 extern	vmCvar_t	g_smoothClients;
+extern	vmCvar_t	g_triggerGrid;
+extern	vmCvar_t	g_coalesceCommands;
 extern	vmCvar_t	pmove_fixed;
 extern	vmCvar_t	pmove_msec;
 extern	vmCvar_t	pmove_float;
@@ -1123,6 +1153,9 @@ extern vmCvar_t         g_blueTeamClientNumbers;
 //unlagged - server options
 // some new server-side variables
 extern	vmCvar_t	g_delagHitscan;
+extern	vmCvar_t	g_delagMissiles;
+extern	vmCvar_t	g_delagMissileMax;
+extern	vmCvar_t	g_debugDelagMissiles;
 extern	vmCvar_t	g_truePing;
 // this is for convenience - using "sv_fps.integer" is nice :)
 extern	vmCvar_t	sv_fps;
@@ -1192,6 +1225,13 @@ void	trap_LinkEntity( gentity_t *ent );
 void	trap_UnlinkEntity( gentity_t *ent );
 int		trap_EntitiesInBox( const vec3_t mins, const vec3_t maxs, int *entityList, int maxcount );
 qboolean trap_EntityContact( const vec3_t mins, const vec3_t maxs, const gentity_t *ent );
+
+// keep the trigger grid and pushable list in step with the server's view of the world
+#define trap_LinkEntity(ent) \
+	( trap_LinkEntity(ent), G_RefileTrigger(ent), G_RefilePushable(ent) )
+#define trap_UnlinkEntity(ent) \
+	( trap_UnlinkEntity(ent), G_RefileTrigger(ent), G_RefilePushable(ent) )
+
 int		trap_BotAllocateClient( void );
 void	trap_BotFreeClient( int clientNum );
 void	trap_GetUsercmd( int clientNum, usercmd_t *cmd );
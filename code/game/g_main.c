@@ -88,6 +88,8 @@ vmCvar_t	g_teamForceBalance;
 vmCvar_t	g_banIPs;
 vmCvar_t	g_filterBan;
 vmCvar_t	g_smoothClients;
+vmCvar_t	g_triggerGrid;
+vmCvar_t	g_coalesceCommands;
 vmCvar_t	pmove_fixed;
 vmCvar_t	pmove_msec;
 vmCvar_t        pmove_float;
@@ -170,6 +172,9 @@ vmCvar_t         g_blueTeamClientNumbers;
 
 //unlagged - server options
 vmCvar_t	g_delagHitscan;
+vmCvar_t	g_delagMissiles;
+vmCvar_t	g_delagMissileMax;
+vmCvar_t	g_debugDelagMissiles;
 vmCvar_t	g_truePing;
 vmCvar_t	sv_fps;
 vmCvar_t        g_lagLightning; //Adds a little lag to the lightninggun to make it less powerfull
@@ -304,6 +309,9 @@ static cvarTable_t		gameCvarTable[] = {
 	{ &g_proxMineTimeout, "g_proxMineTimeout", "20000", 0, 0, qfalse },
 
 	{ &g_smoothClients, "g_smoothClients", "1", 0, 0, qfalse},
+	{ &g_triggerGrid, "g_triggerGrid", "1", 0, 0, qfalse},
+	// merge identical pmove_fixed commands of a client until the next frame
+	{ &g_coalesceCommands, "g_coalesceCommands", "0", CVAR_ARCHIVE, 0, qfalse},
 	{ &pmove_fixed, "pmove_fixed", "0", CVAR_SYSTEMINFO | CVAR_ARCHIVE, 0, qfalse},
 	{ &pmove_msec, "pmove_msec", "11", CVAR_SYSTEMINFO | CVAR_ARCHIVE, 0, qfalse},
 
@@ -311,6 +319,10 @@ static cvarTable_t		gameCvarTable[] = {
 
 //unlagged - server options
 	{ &g_delagHitscan, "g_delagHitscan", "0", CVAR_ARCHIVE | CVAR_SERVERINFO, 0, qtrue },
+	// bit ( 1 << weapon ) for every missile weapon that is fast-forwarded
+	{ &g_delagMissiles, "g_delagMissiles", "0", CVAR_ARCHIVE | CVAR_SERVERINFO, 0, qtrue },
+	{ &g_delagMissileMax, "g_delagMissileMax", "150", CVAR_ARCHIVE, 0, qtrue },
+	{ &g_debugDelagMissiles, "g_debugDelagMissiles", "0", 0, 0, qfalse },
 	{ &g_truePing, "g_truePing", "0", CVAR_ARCHIVE, 0, qtrue },
 	// it's CVAR_SYSTEMINFO so the client's sv_fps will be automagically set to its value
 	{ &sv_fps, "sv_fps", "20", CVAR_SYSTEMINFO | CVAR_ARCHIVE, 0, qfalse },
@@ -535,6 +547,8 @@ void G_FindTeams( void ) {
 				if ( e2->targetname ) {
 					e->targetname = e2->targetname;
 					e2->targetname = NULL;
+					G_ReindexEntity( e );
+					G_ReindexEntity( e2 );
 				}
 			}
 		}
@@ -765,6 +779,9 @@ void G_InitGame( int levelTime, int randomSeed, int restart ) {
 	// initialize all entities for this game
 	memset( g_entities, 0, MAX_GENTITIES * sizeof(g_entities[0]) );
 	level.gentities = g_entities;
+	G_InitEntityIndex();
+	G_InitTriggerGrid();
+	G_InitPushables();
 
 	// initialize all clients for this game
 	level.maxclients = g_maxclients.integer;
@@ -794,6 +811,8 @@ void G_InitGame( int levelTime, int randomSeed, int restart ) {
 
 	ClearRegisteredItems();
 
+	G_ClearSpawnPoints();
+
 	// parse the key/value pairs and spawn gentities
 	G_SpawnEntitiesFromString();
 
@@ -898,6 +917,8 @@ void G_ShutdownGame( int restart ) {
                 level.logFile = 0;
 	}
 
+	G_PmoveRecordStop( -1 );
+
 	// write all the client session data so we can get it back
 	G_WriteSessionData();
 	
@@ -2727,6 +2748,26 @@ void G_RunThink (gentity_t *ent) {
 	ent->think (ent);
 }
 
+static int	missileList[MAX_GENTITIES];
+
+/*
+================
+G_SortMissilesByDelag
+
+Least fast-forwarded first, entity order within the same delag
+================
+*/
+static int QDECL G_SortMissilesByDelag( const void *a, const void *b ) {
+	gentity_t	*ea, *eb;
+
+	ea = &g_entities[*(const int *)a];
+	eb = &g_entities[*(const int *)b];
+	if ( ea->delagMsec != eb->delagMsec ) {
+		return ea->delagMsec - eb->delagMsec;
+	}
+	return *(const int *)a - *(const int *)b;
+}
+
 /*
 ================
 G_RunFrame
@@ -2738,6 +2779,8 @@ void G_RunFrame( int levelTime ) {
 	int			i;
 	gentity_t	*ent;
 	int			msec;
+	int			shiftTime;
+	int			numMissiles;
 int start, end;
 
 	// if we are waiting for the level to restart, do nothing
@@ -2745,6 +2788,10 @@ int start, end;
 		return;
 	}
 
+	// run the commands that were held back since the last frame
+	// while level.time still is the time they arrived at
+	G_FlushClientCommands();
+
 	level.framenum++;
 	level.previousTime = level.time;
 	level.time = levelTime;
@@ -2753,6 +2800,10 @@ int start, end;
 	// get any cvar changes
 	G_UpdateCvars();
 
+	G_SyncEntityIndex();
+	G_SyncTriggerGrid();
+	G_SyncPushables();
+
         if( (g_gametype.integer==GT_ELIMINATION || g_gametype.integer==GT_CTF_ELIMINATION) && !(g_elimflags.integer & EF_NO_FREESPEC) && g_elimination_lockspectator.integer>1)
             trap_Cvar_Set("elimflags",va("%i",g_elimflags.integer|EF_NO_FREESPEC));
         else
@@ -2842,8 +2893,7 @@ int start, end;
 	// NOW run the missiles, with all players backward-reconciled
 	// to the positions they were in exactly 50ms ago, at the end
 	// of the last server frame
-	G_TimeShiftAllClients( level.previousTime, NULL );
-
+	numMissiles = 0;
 	ent = &g_entities[0];
 	for (i=0 ; i<level.num_entities ; i++, ent++) {
 		if ( !ent->inuse ) {
@@ -2856,8 +2906,25 @@ int start, end;
 		}
 
 		if ( ent->s.eType == ET_MISSILE ) {
-			G_RunMissile( ent );
+			missileList[numMissiles++] = i;
+		}
+	}
+
+	// a fast-forwarded missile sees everyone where its owner did, so
+	// run the missiles grouped by that and shift once for each group
+	qsort( missileList, numMissiles, sizeof( missileList[0] ), G_SortMissilesByDelag );
+
+	shiftTime = 0;
+	for (i=0 ; i<numMissiles ; i++) {
+		ent = &g_entities[missileList[i]];
+		if ( !ent->inuse || ent->freeAfterEvent || ent->s.eType != ET_MISSILE ) {
+			continue;
+		}
+		if ( !i || level.previousTime - ent->delagMsec != shiftTime ) {
+			shiftTime = level.previousTime - ent->delagMsec;
+			G_TimeShiftAllClients( shiftTime, NULL );
 		}
+		G_RunMissile( ent );
 	}
 
 	G_UnTimeShiftAllClients( NULL );
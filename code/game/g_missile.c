@@ -24,6 +24,10 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #define	MISSILE_PRESTEP_TIME	50
 
+// the span of time G_MissileMove is currently moving a missile through,
+// the last server frame unless a new missile is being fast-forwarded
+static int	missilePrevTime, missileTime;
+
 /*
 ================
 G_BounceMissile
@@ -36,7 +40,7 @@ void G_BounceMissile( gentity_t *ent, trace_t *trace ) {
 	int		hitTime;
 
 	// reflect the velocity on the trace plane
-	hitTime = level.previousTime + ( level.time - level.previousTime ) * trace->fraction;
+	hitTime = missilePrevTime + ( missileTime - missilePrevTime ) * trace->fraction;
 	BG_EvaluateTrajectoryDelta( &ent->s.pos, hitTime, velocity );
 	dot = DotProduct( velocity, trace->plane.normal );
 	VectorMA( velocity, -2*dot, trace->plane.normal, ent->s.pos.trDelta );
@@ -53,7 +57,7 @@ void G_BounceMissile( gentity_t *ent, trace_t *trace ) {
 
 	VectorAdd( ent->r.currentOrigin, trace->plane.normal, ent->r.currentOrigin);
 	VectorCopy( ent->r.currentOrigin, ent->s.pos.trBase );
-	ent->s.pos.trTime = level.time;
+	ent->s.pos.trTime = missileTime;
 }
 
 
@@ -487,16 +491,22 @@ void G_MissileImpact( gentity_t *ent, trace_t *trace ) {
 
 /*
 ================
-G_RunMissile
+G_MissileMove
+
+Moves a missile from where it is to where it is at "time", which ends
+the span starting at prevTime.  Returns qfalse if it exploded.
 ================
 */
-void G_RunMissile( gentity_t *ent ) {
+static qboolean G_MissileMove( gentity_t *ent, int prevTime, int time ) {
 	vec3_t		origin;
 	trace_t		tr;
 	int			passent;
 
+	missilePrevTime = prevTime;
+	missileTime = time;
+
 	// get current position
-	BG_EvaluateTrajectory( &ent->s.pos, level.time, origin );
+	BG_EvaluateTrajectory( &ent->s.pos, time, origin );
 
 	// if this missile bounced off an invulnerability sphere
 	if ( ent->target_ent ) {
@@ -532,11 +542,16 @@ void G_RunMissile( gentity_t *ent ) {
 				ent->parent->client->hook = NULL;
 			}
 			G_FreeEntity( ent );
-			return;
+			return qfalse;
+		}
+		if ( ent->delagMsec && g_debugDelagMissiles.integer && tr.entityNum < MAX_CLIENTS
+			&& g_entities[ent->r.ownerNum].client ) {
+			trap_SendServerCommand( ent->r.ownerNum, va( "print \"delag: %s hit client %i %i ms after firing, %i ms ahead\n\"",
+				ent->classname, tr.entityNum, time - ent->s.pos.trTime - MISSILE_PRESTEP_TIME, ent->delagMsec ) );
 		}
 		G_MissileImpact( ent, &tr );
 		if ( ent->s.eType != ET_MISSILE ) {
-			return;		// exploded
+			return qfalse;		// exploded
 		}
 	}
 	// if the prox mine wasn't yet outside the player body
@@ -547,10 +562,91 @@ void G_RunMissile( gentity_t *ent ) {
 			ent->count = 1;
 		}
 	}
+	return qtrue;
+}
+
+/*
+================
+G_RunMissile
+================
+*/
+void G_RunMissile( gentity_t *ent ) {
+	if ( !G_MissileMove( ent, level.previousTime, level.time ) ) {
+		return;
+	}
+
 	// check think function after bouncing
 	G_RunThink( ent );
 }
 
+/*
+================
+G_DelagMissile
+
+Fast-forwards a missile that was just fired by ent to where it would
+be if it had left the muzzle when ent pressed fire, tracing against
+everyone where ent saw them along the way.  The missile remembers how
+far ahead it is so G_RunFrame can keep tracing it against the world
+as its owner sees it.  Must be called after damage is set.
+================
+*/
+#define	DELAG_MISSILE_STEP	25
+
+void G_DelagMissile( gentity_t *ent, gentity_t *missile ) {
+	int		shiftTime, msec, start, t, prev;
+	qboolean	exploded;
+
+	if ( !g_delagMissiles.integer || !ent->client || ( ent->r.svFlags & SVF_BOT ) ) {
+		return;
+	}
+	if ( !( g_delagMissiles.integer & ( 1 << missile->s.weapon ) ) || !( ent->client->pers.delag & 1 ) ) {
+		return;
+	}
+
+	// the same time G_DoTimeShiftFor rewinds hitscan to
+	shiftTime = ent->client->attackTime + ent->client->pers.cmdTimeNudge;
+	msec = level.previousTime + ent->client->frameOffset - shiftTime;
+	if ( msec > g_delagMissileMax.integer ) {
+		msec = g_delagMissileMax.integer;
+	}
+	if ( msec <= 0 ) {
+		return;
+	}
+
+	// after this the trajectory is msec further along at any given time
+	missile->s.pos.trTime -= msec;
+	missile->delagMsec = msec;
+
+	// and the fuse has burned just as long
+	if ( missile->nextthink ) {
+		missile->nextthink -= msec;
+		if ( missile->nextthink < level.time ) {
+			missile->nextthink = level.time;
+		}
+	}
+
+	start = level.time - msec;
+	exploded = qfalse;
+	for ( t = 0 ; t < msec ; ) {
+		prev = t;
+		t += DELAG_MISSILE_STEP;
+		if ( t > msec ) {
+			t = msec;
+		}
+		G_TimeShiftAllClients( shiftTime + t, ent );
+		if ( !G_MissileMove( missile, start + prev, start + t ) ) {
+			exploded = qtrue;
+			break;
+		}
+	}
+	G_UnTimeShiftAllClients( ent );
+
+	if ( g_debugDelagMissiles.integer ) {
+		trap_SendServerCommand( ent - g_entities, va( "print \"delag: %s forwarded %i ms%s\n\"",
+			missile->classname, msec, exploded ? ", exploded" : "" ) );
+	}
+}
+
 
 //=============================================================================
 
@@ -43,6 +43,102 @@ typedef struct {
 } pushed_t;
 pushed_t	pushed[MAX_GENTITIES], *pushed_p;
 
+/*
+Everything G_MoverPush can do something with is kept in a list that is
+updated whenever an entity is linked or unlinked, so a mover only has
+to look through the players, items and missiles near it instead of
+asking the server for every entity in its swept volume.  Most movers
+have nothing near them and skip the rest of the push.
+G_SyncPushables picks up type changes made without a relink.
+*/
+static short	pushables[MAX_GENTITIES];
+static short	pushableSlot[MAX_GENTITIES];		// -1 when not listed
+static int		numPushables;
+
+/*
+============
+G_InitPushables
+============
+*/
+void G_InitPushables( void ) {
+	memset( pushableSlot, -1, sizeof( pushableSlot ) );
+	numPushables = 0;
+}
+
+/*
+============
+G_RefilePushable
+
+Called whenever ent has been linked or unlinked
+============
+*/
+void G_RefilePushable( gentity_t *ent ) {
+	qboolean	pushable;
+	int			num, slot;
+
+	num = ent - g_entities;
+	pushable = ent->r.linked && ( ent->s.eType == ET_MISSILE || ent->s.eType == ET_ITEM
+		|| ent->s.eType == ET_PLAYER || ent->physicsObject );
+
+	slot = pushableSlot[num];
+	if ( pushable == ( slot >= 0 ) ) {
+		return;
+	}
+
+	if ( pushable ) {
+		pushableSlot[num] = numPushables;
+		pushables[numPushables++] = num;
+	} else {
+		numPushables--;
+		pushables[slot] = pushables[numPushables];
+		pushableSlot[pushables[slot]] = slot;
+		pushableSlot[num] = -1;
+	}
+}
+
+/*
+============
+G_SyncPushables
+============
+*/
+void G_SyncPushables( void ) {
+	int		i;
+
+	for ( i = 0 ; i < level.num_entities ; i++ ) {
+		G_RefilePushable( &g_entities[i] );
+	}
+}
+
+/*
+============
+G_PushablesInBox
+
+Like trap_EntitiesInBox, but only returns entities a mover can push
+or crush, in entity order
+============
+*/
+static int G_PushablesInBox( const vec3_t mins, const vec3_t maxs, short *list ) {
+	gentity_t	*check;
+	int			i, j, num, count;
+
+	count = 0;
+	for ( i = 0 ; i < numPushables ; i++ ) {
+		check = &g_entities[pushables[i]];
+		if ( check->r.absmin[0] > maxs[0] || check->r.absmin[1] > maxs[1] || check->r.absmin[2] > maxs[2]
+			|| check->r.absmax[0] < mins[0] || check->r.absmax[1] < mins[1] || check->r.absmax[2] < mins[2] ) {
+			continue;
+		}
+
+		num = pushables[i];
+		for ( j = count ; j > 0 && list[j - 1] > num ; j-- ) {
+			list[j] = list[j - 1];
+		}
+		list[j] = num;
+		count++;
+	}
+	return count;
+}
+
 
 /*
 ============
@@ -268,7 +364,7 @@ qboolean G_MoverPush( gentity_t *pusher, vec3_t move, vec3_t amove, gentity_t **
 	gentity_t	*check;
 	vec3_t		mins, maxs;
 	pushed_t	*p;
-	int			entityList[MAX_GENTITIES];
+	short		entityList[MAX_GENTITIES];
 	int			listedEntities;
 	vec3_t		totalMins, totalMaxs;
 
@@ -305,10 +401,8 @@ qboolean G_MoverPush( gentity_t *pusher, vec3_t move, vec3_t amove, gentity_t **
 		}
 	}
 
-	// unlink the pusher so we don't get it in the entityList
-	trap_UnlinkEntity( pusher );
-
-	listedEntities = trap_EntitiesInBox( totalMins, totalMaxs, entityList, MAX_GENTITIES );
+	// the pusher itself is never in the list, movers aren't pushable
+	listedEntities = G_PushablesInBox( totalMins, totalMaxs, entityList );
 
 	// move the pusher to it's final position
 	VectorAdd( pusher->r.currentOrigin, move, pusher->r.currentOrigin );
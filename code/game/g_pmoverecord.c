@@ -0,0 +1,143 @@
+/*
+===========================================================================
+Copyright (C) 1999-2005 Id Software, Inc.
+
+This file is part of Quake III Arena source code.
+
+Quake III Arena source code is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of the License,
+or (at your option) any later version.
+
+Quake III Arena source code is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Quake III Arena source code; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+===========================================================================
+*/
+//
+// g_pmoverecord.c -- record the Pmove inputs of one client
+//
+// "pmoverecord <player> [file]" writes the playerState of that player
+// and then the pmove_t inputs of every Pmove the server runs for them
+// to a file.  "pmoverecord stop" closes it again.
+//
+// The recordings are replayed by code/tools/pmovetest, which runs them
+// through bg_pmove.c and bg_slidemove.c outside the game, against a
+// world of its own.  See g_pmoverecord.h for the file format.
+
+#include "g_local.h"
+#include "g_pmoverecord.h"
+
+static fileHandle_t		recordFile;
+static int				recordClient = -1;
+static int				recordCount;
+
+/*
+=================
+G_PmoveRecordStop
+
+Stops the recording of clientNum, -1 stops any recording
+=================
+*/
+void G_PmoveRecordStop( int clientNum ) {
+	if ( !recordFile ) {
+		return;
+	}
+	if ( clientNum != -1 && clientNum != recordClient ) {
+		return;
+	}
+	trap_FS_FCloseFile( recordFile );
+	recordFile = 0;
+	recordClient = -1;
+	G_Printf( "pmoverecord: %i moves recorded\n", recordCount );
+}
+
+/*
+=================
+G_PmoveRecord
+
+Called right before ClientThink_real runs Pmove
+=================
+*/
+void G_PmoveRecord( gentity_t *ent, pmove_t *pm ) {
+	pmoveRecordHeader_t	header;
+	pmoveRecord_t		rec;
+
+	if ( ent->s.number != recordClient || !recordFile ) {
+		return;
+	}
+
+	// the replay starts from the state the first move started from
+	if ( !recordCount ) {
+		memset( &header, 0, sizeof( header ) );
+		header.ident = PMOVEREC_IDENT;
+		header.version = PMOVEREC_VERSION;
+		header.recordSize = sizeof( pmoveRecord_t );
+		trap_Cvar_VariableStringBuffer( "mapname", header.mapname, sizeof( header.mapname ) );
+		header.start = *pm->ps;
+		trap_FS_Write( &header, sizeof( header ), recordFile );
+	}
+
+	memset( &rec, 0, sizeof( rec ) );
+	rec.cmd = pm->cmd;
+	rec.tracemask = pm->tracemask;
+	rec.noFootsteps = pm->noFootsteps;
+	rec.gauntletHit = pm->gauntletHit;
+	rec.pmove_fixed = pm->pmove_fixed;
+	rec.pmove_msec = pm->pmove_msec;
+	rec.pmove_float = pm->pmove_float;
+	rec.pmove_flags = pm->pmove_flags;
+	trap_FS_Write( &rec, sizeof( rec ), recordFile );
+	recordCount++;
+}
+
+/*
+=================
+Svcmd_PmoveRecord_f
+
+pmoverecord <player> [file]
+pmoverecord stop
+=================
+*/
+void Svcmd_PmoveRecord_f( void ) {
+	gclient_t	*cl;
+	char		str[MAX_TOKEN_CHARS];
+	char		filename[MAX_QPATH];
+
+	if ( trap_Argc() < 2 ) {
+		G_Printf( "usage: pmoverecord <player> [file]\n       pmoverecord stop\n" );
+		return;
+	}
+
+	trap_Argv( 1, str, sizeof( str ) );
+	G_PmoveRecordStop( -1 );
+	if ( !Q_stricmp( str, "stop" ) ) {
+		return;
+	}
+
+	cl = ClientForString( str );
+	if ( !cl ) {
+		return;
+	}
+
+	if ( trap_Argc() > 2 ) {
+		trap_Argv( 2, filename, sizeof( filename ) );
+	} else {
+		Q_strncpyz( filename, PMOVEREC_FILE, sizeof( filename ) );
+	}
+
+	if ( trap_FS_FOpenFile( filename, &recordFile, FS_WRITE ) < 0 || !recordFile ) {
+		G_Printf( "Couldn't open %s for writing.\n", filename );
+		recordFile = 0;
+		return;
+	}
+
+	recordClient = cl - level.clients;
+	recordCount = 0;
+	G_Printf( "pmoverecord: recording %s to %s\n", cl->pers.netname, filename );
+}
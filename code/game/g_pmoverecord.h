@@ -0,0 +1,55 @@
+/*
+===========================================================================
+Copyright (C) 1999-2005 Id Software, Inc.
+
+This file is part of Quake III Arena source code.
+
+Quake III Arena source code is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of the License,
+or (at your option) any later version.
+
+Quake III Arena source code is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Quake III Arena source code; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+===========================================================================
+*/
+//
+//
+// g_pmoverecord.h -- file format of the pmoverecord command
+//
+// Shared with code/tools/pmovetest, which replays the recordings
+// outside the game.  A recording is one pmoveRecordHeader_t holding
+// the playerState before the first move, followed by one
+// pmoveRecord_t for every Pmove the server ran for the player.
+// The structs are written as they are in memory, so a recording
+// only loads on a platform with the same int and float layout.
+
+#define	PMOVEREC_IDENT		(('C'<<24)+('R'<<16)+('M'<<8)+'P')
+#define	PMOVEREC_VERSION	2
+#define	PMOVEREC_FILE		"pmove.rec"
+
+typedef struct {
+	int			ident;
+	int			version;
+	int			recordSize;
+	char		mapname[MAX_QPATH];
+	playerState_t	start;
+} pmoveRecordHeader_t;
+
+// the pmove_t inputs of one Pmove
+typedef struct {
+	usercmd_t	cmd;
+	int			tracemask;
+	qboolean	noFootsteps;
+	qboolean	gauntletHit;
+	int			pmove_fixed;
+	int			pmove_msec;
+	int			pmove_float;
+	int			pmove_flags;
+} pmoveRecord_t;
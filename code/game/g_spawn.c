@@ -290,6 +290,223 @@ spawn_t	spawns[] = {
 	{NULL, 0}
 };
 
+/*
+=============================================================================
+
+SPAWN TABLES
+
+The item, spawn function and field names are hashed into open
+addressed tables the first time a level is spawned, so every entity
+costs a single probe instead of a scan of bg_itemlist, spawns[] and
+fields[].  Each distinct classname in the map also has its
+replace_<classname> cvar read once, the first time it is seen, and
+remembers what it resolved to for the rest of the level.
+
+=============================================================================
+*/
+
+#define	SPAWN_HASH_SIZE		1024		// power of two, at least twice the items plus spawns
+#define	FIELD_HASH_SIZE		64			// power of two, at least twice the fields
+#define	CLASS_CACHE_SIZE	512			// power of two
+#define	MAX_CLASSNAME		64
+
+typedef struct {
+	gitem_t		*item;					// checked before spawn, like the scan was
+	spawn_t		*spawn;
+} spawnTarget_t;
+
+typedef struct {
+	char			classname[MAX_CLASSNAME];	// empty for a free slot
+	char			itemname[128];				// after the replace cvar
+	qboolean		replaced;
+	spawnTarget_t	target;
+} classCache_t;
+
+static spawnTarget_t	spawnHash[SPAWN_HASH_SIZE];
+static const char		*spawnHashNames[SPAWN_HASH_SIZE];
+static field_t			*fieldHash[FIELD_HASH_SIZE];
+static qboolean			spawnTablesBuilt;
+
+static classCache_t		classCache[CLASS_CACHE_SIZE];
+static int				classCacheUsed;
+
+/*
+===============
+G_SpawnNameHash
+
+ignoreCase matches the comparison the table is searched with
+===============
+*/
+static unsigned G_SpawnNameHash( const char *s, qboolean ignoreCase ) {
+	unsigned	hash;
+	int			c;
+
+	hash = 2166136261u;
+	for ( ; *s ; s++ ) {
+		c = (unsigned char)*s;
+		if ( ignoreCase ) {
+			c = tolower( c );
+		}
+		hash = ( hash ^ c ) * 16777619u;
+	}
+	return hash ^ ( hash >> 15 );
+}
+
+/*
+===============
+G_FindSpawnSlot
+
+Slot holding name, or the empty slot it would go in
+===============
+*/
+static int G_FindSpawnSlot( const char *name ) {
+	int		i;
+
+	i = G_SpawnNameHash( name, qfalse ) & ( SPAWN_HASH_SIZE - 1 );
+	while ( spawnHashNames[i] && strcmp( spawnHashNames[i], name ) ) {
+		i = ( i + 1 ) & ( SPAWN_HASH_SIZE - 1 );
+	}
+	return i;
+}
+
+/*
+===============
+G_BuildSpawnTables
+===============
+*/
+static void G_BuildSpawnTables( void ) {
+	gitem_t	*item;
+	spawn_t	*s;
+	field_t	*f;
+	int		i, count;
+
+	if ( spawnTablesBuilt ) {
+		return;
+	}
+
+	count = 0;
+	for ( item = bg_itemlist + 1 ; item->classname ; item++ ) {
+		i = G_FindSpawnSlot( item->classname );
+		if ( !spawnHashNames[i] ) {
+			if ( ++count > SPAWN_HASH_SIZE / 2 ) {
+				G_Error( "G_BuildSpawnTables: SPAWN_HASH_SIZE too small" );
+			}
+			spawnHashNames[i] = item->classname;
+			spawnHash[i].item = item;
+		}
+	}
+	for ( s = spawns ; s->name ; s++ ) {
+		i = G_FindSpawnSlot( s->name );
+		if ( !spawnHashNames[i] ) {
+			if ( ++count > SPAWN_HASH_SIZE / 2 ) {
+				G_Error( "G_BuildSpawnTables: SPAWN_HASH_SIZE too small" );
+			}
+			spawnHashNames[i] = s->name;
+		}
+		if ( !spawnHash[i].spawn ) {
+			spawnHash[i].spawn = s;
+		}
+	}
+
+	count = 0;
+	for ( f = fields ; f->name ; f++ ) {
+		i = G_SpawnNameHash( f->name, qtrue ) & ( FIELD_HASH_SIZE - 1 );
+		while ( fieldHash[i] && Q_stricmp( fieldHash[i]->name, f->name ) ) {
+			i = ( i + 1 ) & ( FIELD_HASH_SIZE - 1 );
+		}
+		if ( !fieldHash[i] ) {
+			if ( ++count > FIELD_HASH_SIZE / 2 ) {
+				G_Error( "G_BuildSpawnTables: FIELD_HASH_SIZE too small" );
+			}
+			fieldHash[i] = f;
+		}
+	}
+
+	spawnTablesBuilt = qtrue;
+}
+
+/*
+===============
+G_ClearSpawnOverrides
+
+The replace cvars are read again for every level
+===============
+*/
+static void G_ClearSpawnOverrides( void ) {
+	memset( classCache, 0, sizeof( classCache ) );
+	classCacheUsed = 0;
+}
+
+/*
+===============
+G_ResolveClassname
+
+Applies the replace cvar and looks the result up
+===============
+*/
+static void G_ResolveClassname( const char *classname, classCache_t *cc ) {
+	char	cvarname[128];
+	int		i;
+
+	//Construct a replace cvar:
+	Com_sprintf( cvarname, sizeof( cvarname ), "replace_%s", classname );
+
+	//Look an alternative item up:
+	trap_Cvar_VariableStringBuffer( cvarname, cc->itemname, sizeof( cc->itemname ) );
+	if ( cc->itemname[0] == 0 ) { //If nothing found use original
+		Q_strncpyz( cc->itemname, classname, sizeof( cc->itemname ) );
+		cc->replaced = qfalse;
+	} else {
+		cc->replaced = qtrue;
+	}
+
+	memset( &cc->target, 0, sizeof( cc->target ) );
+	if ( cc->itemname[0] ) {
+		i = G_FindSpawnSlot( cc->itemname );
+		if ( spawnHashNames[i] ) {
+			cc->target = spawnHash[i];
+		}
+	}
+}
+
+/*
+===============
+G_ClassOverride
+
+Cache entry for classname, filled in the first time it is seen.
+Names that don't fit are resolved into a scratch entry every time.
+===============
+*/
+static classCache_t *G_ClassOverride( const char *classname ) {
+	static classCache_t	scratch;
+	classCache_t	*cc;
+	int		i;
+
+	if ( strlen( classname ) >= MAX_CLASSNAME ) {
+		G_ResolveClassname( classname, &scratch );
+		return &scratch;
+	}
+
+	i = G_SpawnNameHash( classname, qfalse ) & ( CLASS_CACHE_SIZE - 1 );
+	while ( classCache[i].classname[0] ) {
+		if ( !strcmp( classCache[i].classname, classname ) ) {
+			return &classCache[i];
+		}
+		i = ( i + 1 ) & ( CLASS_CACHE_SIZE - 1 );
+	}
+
+	if ( classCacheUsed >= CLASS_CACHE_SIZE / 2 ) {
+		G_ResolveClassname( classname, &scratch );
+		return &scratch;
+	}
+
+	cc = &classCache[i];
+	classCacheUsed++;
+	Q_strncpyz( cc->classname, classname, sizeof( cc->classname ) );
+	G_ResolveClassname( classname, cc );
+	return cc;
+}
+
 /*
 ===============
 G_CallSpawn
@@ -299,44 +516,31 @@ returning qfalse if not found
 ===============
 */
 qboolean G_CallSpawn( gentity_t *ent ) {
-	spawn_t	*s;
-	gitem_t	*item;
-        char cvarname[128];
-        char itemname[128];
-
-        //Construct a replace cvar:
-	Com_sprintf(cvarname, sizeof(cvarname), "replace_%s", ent->classname);
-
-        //Look an alternative item up:
-        trap_Cvar_VariableStringBuffer(cvarname,itemname,sizeof(itemname));
-        if(itemname[0]==0) //If nothing found use original
-            Com_sprintf(itemname, sizeof(itemname), "%s", ent->classname);
-        else
-            G_Printf ("%s replaced by %s\n", ent->classname, itemname);
+	classCache_t	*cc;
 
+	cc = G_ClassOverride( ent->classname ? ent->classname : "" );
+	if ( cc->replaced ) {
+		G_Printf( "%s replaced by %s\n", ent->classname, cc->itemname );
+	}
 
-	if ( itemname[0]==0) {
-                G_Printf ("G_CallSpawn: NULL classname\n");
+	if ( cc->itemname[0] == 0 ) {
+		G_Printf( "G_CallSpawn: NULL classname\n" );
 		return qfalse;
 	}
 
 	// check item spawn functions
-	for ( item=bg_itemlist+1 ; item->classname ; item++ ) {
-		if ( !strcmp(item->classname, itemname) ) {
-			G_SpawnItem( ent, item );
-			return qtrue;
-		}
+	if ( cc->target.item ) {
+		G_SpawnItem( ent, cc->target.item );
+		return qtrue;
 	}
 
 	// check normal spawn functions
-	for ( s=spawns ; s->name ; s++ ) {
-		if ( !strcmp(s->name, itemname) ) {
-			// found it
-			s->spawn(ent);
-			return qtrue;
-		}
+	if ( cc->target.spawn ) {
+		cc->target.spawn->spawn( ent );
+		return qtrue;
 	}
-        G_Printf ("%s doesn't have a spawn function\n", itemname);
+
+	G_Printf( "%s doesn't have a spawn function\n", cc->itemname );
 	return qfalse;
 }
 
@@ -391,8 +595,10 @@ void G_ParseField( const char *key, const char *value, gentity_t *ent ) {
 	byte	*b;
 	float	v;
 	vec3_t	vec;
+	int		i;
 
-	for ( f=fields ; f->name ; f++ ) {
+	i = G_SpawnNameHash( key, qtrue ) & ( FIELD_HASH_SIZE - 1 );
+	for ( ; ( f = fieldHash[i] ) != NULL ; i = ( i + 1 ) & ( FIELD_HASH_SIZE - 1 ) ) {
 		if ( !Q_stricmp(f->name, key) ) {
 			// found it
 			b = (byte *)ent;
@@ -686,6 +892,9 @@ void G_SpawnEntitiesFromString( void ) {
 	level.spawning = qtrue;
 	level.numSpawnVars = 0;
 
+	G_BuildSpawnTables();
+	G_ClearSpawnOverrides();
+
 	// the worldspawn is not an actual entity, but it still
 	// has a "spawn" function to perform any global setup
 	// needed by a level (setting configstrings or cvars, etc)
@@ -509,6 +509,8 @@ struct
   //Kicks a player by number in the game logic rather than the server number
   { "clientkick_game", qfalse, ClientKick_f },
   { "endgamenow", qfalse, EndGame_f },
+  //Record the movement of a player, see g_pmoverecord.c
+  { "pmoverecord", qfalse, Svcmd_PmoveRecord_f },
 };
 
 /*
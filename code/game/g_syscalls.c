@@ -22,6 +22,10 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 //
 #include "g_local.h"
 
+// the trigger grid and pushable list wrappers in g_local.h
+#undef trap_LinkEntity
+#undef trap_UnlinkEntity
+
 // this file is only included when building a dll
 // g_syscalls.asm is included instead when building a qvm
 #ifdef Q3_VM
@@ -1503,10 +1503,6 @@ go to a random point that doesn't telefrag
 */
 #define	MAX_TEAM_SPAWN_POINTS	32
 gentity_t *SelectRandomTeamSpawnPoint( int teamstate, team_t team ) {
-	gentity_t	*spot;
-	int			count;
-	int			selection;
-	gentity_t	*spots[MAX_TEAM_SPAWN_POINTS];
 	char		*classname;
 
 	if(g_gametype.integer == GT_ELIMINATION) { //change sides every round
@@ -1533,25 +1529,7 @@ gentity_t *SelectRandomTeamSpawnPoint( int teamstate, team_t team ) {
 		else
 			return NULL;
 	}
-	count = 0;
-
-	spot = NULL;
-
-	while ((spot = G_Find (spot, FOFS(classname), classname)) != NULL) {
-		if ( SpotWouldTelefrag( spot ) ) {
-			continue;
-		}
-		spots[ count ] = spot;
-		if (++count == MAX_TEAM_SPAWN_POINTS)
-			break;
-	}
-
-	if ( !count ) {	// no spots that won't telefrag
-		return G_Find( NULL, FOFS(classname), classname);
-	}
-
-	selection = rand() % count;
-	return spots[ selection ];
+	return G_SelectFreeSpawnPoint( classname, MAX_TEAM_SPAWN_POINTS );
 }
 
 /*
@@ -1563,41 +1541,15 @@ go to a random Double Domination Spawn Point
 */
 #define	MAX_TEAM_SPAWN_POINTS	32
 gentity_t *SelectRandomDDSpawnPoint( void ) {
-	gentity_t	*spot;
-	int			count;
-	int			selection;
-	gentity_t	*spots[MAX_TEAM_SPAWN_POINTS];
 	char		*classname;
 
 	
 	classname = "info_player_dd";
 		
-	count = 0;
-
-	spot = NULL;
-
-	while ((spot = G_Find (spot, FOFS(classname), classname)) != NULL) {
-		if ( SpotWouldTelefrag( spot ) ) {
-			continue;
-		}
-		spots[ count ] = spot;
-		if (++count == MAX_TEAM_SPAWN_POINTS)
-			break;
-	}
-
-	if ( !count ) {	// no spots that won't telefrag
-		return G_Find( NULL, FOFS(classname), classname);
-	}
-
-	selection = rand() % count;
-	return spots[ selection ];
+	return G_SelectFreeSpawnPoint( classname, MAX_TEAM_SPAWN_POINTS );
 }
 
 gentity_t *SelectRandomTeamDDSpawnPoint( team_t team ) {
-	gentity_t	*spot;
-	int			count;
-	int			selection;
-	gentity_t	*spots[MAX_TEAM_SPAWN_POINTS];
 	char		*classname;
 
 	if(team == TEAM_RED)
@@ -1605,25 +1557,7 @@ gentity_t *SelectRandomTeamDDSpawnPoint( team_t team ) {
         else
             classname = "info_player_dd_blue";
 		
-	count = 0;
-
-	spot = NULL;
-
-	while ((spot = G_Find (spot, FOFS(classname), classname)) != NULL) {
-		if ( SpotWouldTelefrag( spot ) ) {
-			continue;
-		}
-		spots[ count ] = spot;
-		if (++count == MAX_TEAM_SPAWN_POINTS)
-			break;
-	}
-
-	if ( !count ) {	// no spots that won't telefrag
-		return G_Find( NULL, FOFS(classname), classname);
-	}
-
-	selection = rand() % count;
-	return spots[ selection ];
+	return G_SelectFreeSpawnPoint( classname, MAX_TEAM_SPAWN_POINTS );
 }
 
 
@@ -466,3 +466,295 @@ void SP_func_timer( gentity_t *self ) {
 }
 
 
+
+
+/*
+=============================================================================
+
+TRIGGER GRID
+
+Every linked entity with CONTENTS_TRIGGER is filed in the cells of a
+uniform grid in the XY plane that its absolute bounds cover, so
+G_TouchTriggers only has to look at the triggers near a player instead
+of asking the server for every entity in a box.  Triggers that cover
+too many cells go on a list that is checked every time.
+
+Entities are refiled when they are linked or unlinked, which covers
+moving triggers and items, and G_SyncTriggerGrid catches anything whose
+contents changed without a relink once a frame.  Candidates are
+checked against their current contents and bounds, so a stale entry
+only costs a comparison.
+
+=============================================================================
+*/
+
+#define	TRIGGER_CELL_SHIFT		8			// 256 unit cells
+#define	TRIGGER_GRID_HASH		1024		// power of two
+#define	TRIGGER_MAX_CELLS		16			// more than this goes on the big list
+#define	TRIGGER_GRID_NODES		4096
+
+typedef struct {
+	short	ent;
+	short	next;
+} triggerNode_t;
+
+typedef struct {
+	qboolean	filed;
+	qboolean	big;
+	vec3_t		absmin, absmax;				// bounds the entity is filed with
+	int			cells[4];					// x0, y0, x1, y1
+} triggerFile_t;
+
+static short			triggerBuckets[TRIGGER_GRID_HASH];
+static triggerNode_t	triggerNodes[TRIGGER_GRID_NODES];
+static int				triggerFreeNode;
+static triggerFile_t	triggerFiles[MAX_GENTITIES];
+static short			triggerBig[MAX_GENTITIES];
+static int				numTriggerBig;
+
+static int				triggerStamp[MAX_GENTITIES];
+static int				triggerQuery;
+
+/*
+=================
+G_TriggerBucket
+=================
+*/
+static int G_TriggerBucket( int x, int y ) {
+	return ( ( x * 73856093 ) ^ ( y * 19349663 ) ) & ( TRIGGER_GRID_HASH - 1 );
+}
+
+/*
+=================
+G_TriggerCells
+=================
+*/
+static void G_TriggerCells( const vec3_t mins, const vec3_t maxs, int *cells ) {
+	cells[0] = (int)floor( mins[0] ) >> TRIGGER_CELL_SHIFT;
+	cells[1] = (int)floor( mins[1] ) >> TRIGGER_CELL_SHIFT;
+	cells[2] = (int)floor( maxs[0] ) >> TRIGGER_CELL_SHIFT;
+	cells[3] = (int)floor( maxs[1] ) >> TRIGGER_CELL_SHIFT;
+}
+
+/*
+=================
+G_InitTriggerGrid
+=================
+*/
+void G_InitTriggerGrid( void ) {
+	int		i;
+
+	memset( triggerBuckets, -1, sizeof( triggerBuckets ) );
+	for ( i = 0 ; i < TRIGGER_GRID_NODES - 1 ; i++ ) {
+		triggerNodes[i].next = i + 1;
+	}
+	triggerNodes[i].next = -1;
+	triggerFreeNode = 0;
+
+	memset( triggerFiles, 0, sizeof( triggerFiles ) );
+	numTriggerBig = 0;
+
+	memset( triggerStamp, 0, sizeof( triggerStamp ) );
+	triggerQuery = 0;
+}
+
+/*
+=================
+G_UnfileTrigger
+=================
+*/
+static void G_UnfileTrigger( int num ) {
+	triggerFile_t	*tf;
+	short	*link;
+	int		x, y, n, i;
+
+	tf = &triggerFiles[num];
+	if ( !tf->filed ) {
+		return;
+	}
+	tf->filed = qfalse;
+
+	if ( tf->big ) {
+		for ( i = 0 ; i < numTriggerBig ; i++ ) {
+			if ( triggerBig[i] == num ) {
+				triggerBig[i] = triggerBig[--numTriggerBig];
+				break;
+			}
+		}
+		return;
+	}
+
+	for ( x = tf->cells[0] ; x <= tf->cells[2] ; x++ ) {
+		for ( y = tf->cells[1] ; y <= tf->cells[3] ; y++ ) {
+			// cells that share a bucket are all removed on the first visit
+			link = &triggerBuckets[G_TriggerBucket( x, y )];
+			while ( *link >= 0 ) {
+				n = *link;
+				if ( triggerNodes[n].ent == num ) {
+					*link = triggerNodes[n].next;
+					triggerNodes[n].next = triggerFreeNode;
+					triggerFreeNode = n;
+				} else {
+					link = &triggerNodes[n].next;
+				}
+			}
+		}
+	}
+}
+
+/*
+=================
+G_FileTrigger
+=================
+*/
+static void G_FileTrigger( gentity_t *ent ) {
+	triggerFile_t	*tf;
+	int		num, x, y, n, count;
+
+	num = ent - g_entities;
+	tf = &triggerFiles[num];
+
+	tf->filed = qtrue;
+	VectorCopy( ent->r.absmin, tf->absmin );
+	VectorCopy( ent->r.absmax, tf->absmax );
+	G_TriggerCells( tf->absmin, tf->absmax, tf->cells );
+
+	count = ( tf->cells[2] - tf->cells[0] + 1 ) * ( tf->cells[3] - tf->cells[1] + 1 );
+	tf->big = ( count > TRIGGER_MAX_CELLS );
+
+	if ( !tf->big ) {
+		for ( x = tf->cells[0] ; x <= tf->cells[2] && !tf->big ; x++ ) {
+			for ( y = tf->cells[1] ; y <= tf->cells[3] ; y++ ) {
+				n = triggerFreeNode;
+				if ( n < 0 ) {
+					// out of nodes, take back what was filed and check it every time
+					G_UnfileTrigger( num );
+					tf->filed = qtrue;
+					tf->big = qtrue;
+					break;
+				}
+				triggerFreeNode = triggerNodes[n].next;
+				triggerNodes[n].ent = num;
+				triggerNodes[n].next = triggerBuckets[G_TriggerBucket( x, y )];
+				triggerBuckets[G_TriggerBucket( x, y )] = n;
+			}
+		}
+	}
+
+	if ( tf->big ) {
+		triggerBig[numTriggerBig++] = num;
+	}
+}
+
+/*
+=================
+G_RefileTrigger
+
+Called whenever ent has been linked or unlinked
+=================
+*/
+void G_RefileTrigger( gentity_t *ent ) {
+	triggerFile_t	*tf;
+	int		num;
+
+	num = ent - g_entities;
+	tf = &triggerFiles[num];
+
+	if ( !ent->r.linked || !( ent->r.contents & CONTENTS_TRIGGER ) ) {
+		G_UnfileTrigger( num );
+		return;
+	}
+
+	if ( tf->filed && VectorCompare( tf->absmin, ent->r.absmin )
+		&& VectorCompare( tf->absmax, ent->r.absmax ) ) {
+		return;
+	}
+
+	G_UnfileTrigger( num );
+	G_FileTrigger( ent );
+}
+
+/*
+=================
+G_SyncTriggerGrid
+=================
+*/
+void G_SyncTriggerGrid( void ) {
+	int		i;
+
+	for ( i = 0 ; i < level.num_entities ; i++ ) {
+		G_RefileTrigger( &g_entities[i] );
+	}
+}
+
+/*
+=================
+G_TriggerCandidate
+=================
+*/
+static qboolean G_TriggerCandidate( int num, const vec3_t mins, const vec3_t maxs ) {
+	gentity_t	*hit;
+
+	if ( triggerStamp[num] == triggerQuery ) {
+		return qfalse;
+	}
+	triggerStamp[num] = triggerQuery;
+
+	hit = &g_entities[num];
+	if ( !hit->r.linked || !( hit->r.contents & CONTENTS_TRIGGER ) ) {
+		return qfalse;
+	}
+
+	// same overlap test as trap_EntitiesInBox
+	if ( hit->r.absmin[0] > maxs[0] || hit->r.absmin[1] > maxs[1] || hit->r.absmin[2] > maxs[2]
+		|| hit->r.absmax[0] < mins[0] || hit->r.absmax[1] < mins[1] || hit->r.absmax[2] < mins[2] ) {
+		return qfalse;
+	}
+	return qtrue;
+}
+
+/*
+=================
+G_TriggersInBox
+
+Like trap_EntitiesInBox, but only returns triggers, in entity order
+=================
+*/
+int G_TriggersInBox( const vec3_t mins, const vec3_t maxs, int *list, int maxcount ) {
+	int		cells[4];
+	int		x, y, n, i, j, count, num;
+
+	if ( ++triggerQuery == 0 ) {
+		memset( triggerStamp, 0, sizeof( triggerStamp ) );
+		triggerQuery = 1;
+	}
+
+	count = 0;
+	for ( i = 0 ; i < numTriggerBig && count < maxcount ; i++ ) {
+		if ( G_TriggerCandidate( triggerBig[i], mins, maxs ) ) {
+			list[count++] = triggerBig[i];
+		}
+	}
+
+	G_TriggerCells( mins, maxs, cells );
+	for ( x = cells[0] ; x <= cells[2] ; x++ ) {
+		for ( y = cells[1] ; y <= cells[3] ; y++ ) {
+			for ( n = triggerBuckets[G_TriggerBucket( x, y )] ; n >= 0 ; n = triggerNodes[n].next ) {
+				if ( count < maxcount && G_TriggerCandidate( triggerNodes[n].ent, mins, maxs ) ) {
+					list[count++] = triggerNodes[n].ent;
+				}
+			}
+		}
+	}
+
+	// touch functions run in entity order, whatever order the cells gave
+	for ( i = 1 ; i < count ; i++ ) {
+		num = list[i];
+		for ( j = i ; j > 0 && list[j - 1] > num ; j-- ) {
+			list[j] = list[j - 1];
+		}
+		list[j] = num;
+	}
+
+	return count;
+}
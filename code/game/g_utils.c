@@ -144,6 +144,191 @@ void G_TeamCommand( team_t team, char *cmd ) {
 }
 
 
+/*
+=============================================================================
+
+ENTITY INDEX
+
+G_Find on classname, targetname and target only walks the entities
+filed under the hash of the string it is looking for.  Entities are
+filed by the pointer in the field, which is how a change is noticed:
+
+G_Spawn queues the new entity, because its fields are only set after
+it returns, and the queue is filed before the next lookup.
+G_FreeEntity takes the entity out.  G_SyncEntityIndex refiles anything
+else that changed once a frame, so code that changes one of these
+fields on an entity that is already filed and looks for it again in
+the same frame has to call G_ReindexEntity.
+
+Lookups still compare the strings, so a stale entry can make G_Find
+miss an entity until it is refiled, but never return a wrong one.
+
+=============================================================================
+*/
+
+#define	ENTITY_HASH_SIZE	256		// power of two
+
+typedef struct {
+	int		fieldofs;
+	short	head[ENTITY_HASH_SIZE];		// -1 for empty, chains sorted by entity number
+	short	next[MAX_GENTITIES];
+	char	*filed[MAX_GENTITIES];		// value the entity is filed under, NULL for none
+} entityIndex_t;
+
+static entityIndex_t	entityIndex[3];
+static int				numEntityIndexes;
+
+static short			indexQueue[MAX_GENTITIES];
+static qboolean			indexQueued[MAX_GENTITIES];
+static int				indexQueueLength;
+
+/*
+=============
+G_EntityHash
+=============
+*/
+static int G_EntityHash( const char *s ) {
+	unsigned	hash;
+
+	hash = 2166136261u;
+	while ( *s ) {
+		hash = ( hash ^ (unsigned char)tolower( *s ) ) * 16777619u;
+		s++;
+	}
+	hash ^= hash >> 16;
+	return hash & ( ENTITY_HASH_SIZE - 1 );
+}
+
+/*
+=============
+G_InitEntityIndex
+
+Called after g_entities has been cleared
+=============
+*/
+void G_InitEntityIndex( void ) {
+	static const int	fields[] = { FOFS(classname), FOFS(targetname), FOFS(target) };
+	entityIndex_t	*idx;
+	int				i;
+
+	numEntityIndexes = sizeof( fields ) / sizeof( fields[0] );
+	for ( i = 0, idx = entityIndex ; i < numEntityIndexes ; i++, idx++ ) {
+		idx->fieldofs = fields[i];
+		memset( idx->head, -1, sizeof( idx->head ) );
+		memset( idx->filed, 0, sizeof( idx->filed ) );
+	}
+
+	memset( indexQueued, 0, sizeof( indexQueued ) );
+	indexQueueLength = 0;
+}
+
+/*
+=============
+G_EntityIndexForField
+=============
+*/
+static entityIndex_t *G_EntityIndexForField( int fieldofs ) {
+	int		i;
+
+	for ( i = 0 ; i < numEntityIndexes ; i++ ) {
+		if ( entityIndex[i].fieldofs == fieldofs ) {
+			return &entityIndex[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+=============
+G_ReindexEntity
+
+Files ent under the current values of its indexed fields
+=============
+*/
+void G_ReindexEntity( gentity_t *ent ) {
+	entityIndex_t	*idx;
+	char	*value;
+	short	*link;
+	int		num, i;
+
+	num = ent - g_entities;
+	for ( i = 0, idx = entityIndex ; i < numEntityIndexes ; i++, idx++ ) {
+		value = ent->inuse ? *(char **)( (byte *)ent + idx->fieldofs ) : NULL;
+		if ( value == idx->filed[num] ) {
+			continue;
+		}
+
+		if ( idx->filed[num] ) {
+			link = &idx->head[G_EntityHash( idx->filed[num] )];
+			while ( *link != num ) {
+				link = &idx->next[*link];
+			}
+			*link = idx->next[num];
+		}
+
+		idx->filed[num] = value;
+		if ( value ) {
+			link = &idx->head[G_EntityHash( value )];
+			while ( *link >= 0 && *link < num ) {
+				link = &idx->next[*link];
+			}
+			idx->next[num] = *link;
+			*link = num;
+		}
+	}
+}
+
+/*
+=============
+G_QueueReindex
+=============
+*/
+static void G_QueueReindex( gentity_t *ent ) {
+	int		num;
+
+	num = ent - g_entities;
+	if ( !indexQueued[num] ) {
+		indexQueued[num] = qtrue;
+		indexQueue[indexQueueLength++] = num;
+	}
+}
+
+/*
+=============
+G_FlushReindexQueue
+=============
+*/
+static void G_FlushReindexQueue( void ) {
+	int		i;
+
+	for ( i = 0 ; i < indexQueueLength ; i++ ) {
+		indexQueued[indexQueue[i]] = qfalse;
+		G_ReindexEntity( &g_entities[indexQueue[i]] );
+	}
+	indexQueueLength = 0;
+}
+
+/*
+=============
+G_SyncEntityIndex
+
+Called once a frame to pick up field changes nobody told us about
+=============
+*/
+void G_SyncEntityIndex( void ) {
+	int		i;
+
+	for ( i = 0 ; i < MAX_GENTITIES ; i++ ) {
+		indexQueued[i] = qfalse;
+	}
+	indexQueueLength = 0;
+
+	for ( i = 0 ; i < level.num_entities ; i++ ) {
+		G_ReindexEntity( &g_entities[i] );
+	}
+}
+
+
 /*
 =============
 G_Find
@@ -158,7 +343,31 @@ NULL will be returned if the end of the list is reached.
 */
 gentity_t *G_Find (gentity_t *from, int fieldofs, const char *match)
 {
+	entityIndex_t	*idx;
+	gentity_t	*e;
 	char	*s;
+	int		start, num;
+
+	idx = match ? G_EntityIndexForField( fieldofs ) : NULL;
+	if ( idx ) {
+		G_FlushReindexQueue();
+
+		start = from ? from - g_entities + 1 : 0;
+		for ( num = idx->head[G_EntityHash( match )] ; num >= 0 ; num = idx->next[num] ) {
+			if ( num < start ) {
+				continue;
+			}
+			e = &g_entities[num];
+			if ( !e->inuse || num >= level.num_entities ) {
+				continue;
+			}
+			s = *(char **) ((byte *)e + fieldofs);
+			if ( s && !Q_stricmp( s, match ) ) {
+				return e;
+			}
+		}
+		return NULL;
+	}
 
 	if (!from)
 		from = g_entities;
@@ -409,6 +618,7 @@ gentity_t *G_Spawn( void ) {
 
 			// reuse this slot
 			G_InitGentity( e );
+			G_QueueReindex( e );
 			return e;
 		}
 		if ( i != MAX_GENTITIES ) {
@@ -430,6 +640,7 @@ gentity_t *G_Spawn( void ) {
 		&level.clients[0].ps, sizeof( level.clients[0] ) );
 
 	G_InitGentity( e );
+	G_QueueReindex( e );
 	return e;
 }
 
@@ -472,6 +683,7 @@ void G_FreeEntity( gentity_t *ed ) {
 	ed->classname = "freed";
 	ed->freetime = level.time;
 	ed->inuse = qfalse;
+	G_ReindexEntity( ed );
 }
 
 /*
@@ -35,9 +35,13 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 int				ui_numBots;
 static char		*ui_botInfos[MAX_BOTS];
+static infoIndex_t	ui_botIndex;		// by name
 
 static int		ui_numArenas;
 static char		*ui_arenaInfos[MAX_ARENAS];
+static infoIndex_t	ui_arenaIndex;		// by map
+static infoIndex_t	ui_specialIndex;	// by special
+static int		ui_arenaByNumber[MAX_ARENAS];	// "num" key to arena
 
 static int		ui_numSinglePlayerArenas;
 static int		ui_numSpecialSinglePlayerArenas;
@@ -259,6 +263,24 @@ static void UI_LoadArenas( void ) {
 
 		Info_SetValueForKey( ui_arenaInfos[n], "num", va( "%i", otherNum++ ) );
 	}
+
+	// index what the arenas are looked up by
+	BG_InitInfoIndex( &ui_arenaIndex );
+	BG_InitInfoIndex( &ui_specialIndex );
+	for( n = 0; n < ui_numArenas; n++ ) {
+		ui_arenaByNumber[n] = -1;
+	}
+	for( n = 0; n < ui_numArenas; n++ ) {
+		BG_AddToInfoIndex( &ui_arenaIndex, n, Info_ValueForKey( ui_arenaInfos[n], "map" ) );
+		tag = Info_ValueForKey( ui_arenaInfos[n], "special" );
+		if( *tag ) {
+			BG_AddToInfoIndex( &ui_specialIndex, n, tag );
+		}
+		i = atoi( Info_ValueForKey( ui_arenaInfos[n], "num" ) );
+		if( i >= 0 && i < ui_numArenas && ui_arenaByNumber[i] < 0 ) {
+			ui_arenaByNumber[i] = n;
+		}
+	}
 }
 
 /*
@@ -267,22 +289,15 @@ UI_GetArenaInfoByNumber
 ===============
 */
 const char *UI_GetArenaInfoByNumber( int num ) {
-	int		n;
-	char	*value;
-
 	if( num < 0 || num >= ui_numArenas ) {
 		trap_Print( va( S_COLOR_RED "Invalid arena number: %i\n", num ) );
 		return NULL;
 	}
 
-	for( n = 0; n < ui_numArenas; n++ ) {
-		value = Info_ValueForKey( ui_arenaInfos[n], "num" );
-		if( *value && atoi(value) == num ) {
-			return ui_arenaInfos[n];
-		}
+	if( ui_arenaByNumber[num] < 0 ) {
+		return NULL;
 	}
-
-	return NULL;
+	return ui_arenaInfos[ui_arenaByNumber[num]];
 }
 
 
@@ -294,6 +309,14 @@ UI_GetArenaInfoByNumber
 const char *UI_GetArenaInfoByMap( const char *map ) {
 	int			n;
 
+	n = BG_FindInInfoIndex( &ui_arenaIndex, map );
+	if( n >= 0 ) {
+		return ui_arenaInfos[n];
+	}
+	if( !ui_arenaIndex.overflow ) {
+		return NULL;
+	}
+
 	for( n = 0; n < ui_numArenas; n++ ) {
 		if( Q_stricmp( Info_ValueForKey( ui_arenaInfos[n], "map" ), map ) == 0 ) {
 			return ui_arenaInfos[n];
@@ -312,6 +335,14 @@ UI_GetSpecialArenaInfo
 const char *UI_GetSpecialArenaInfo( const char *tag ) {
 	int			n;
 
+	n = BG_FindInInfoIndex( &ui_specialIndex, tag );
+	if( n >= 0 ) {
+		return ui_arenaInfos[n];
+	}
+	if( !ui_specialIndex.overflow ) {
+		return NULL;
+	}
+
 	for( n = 0; n < ui_numArenas; n++ ) {
 		if( Q_stricmp( Info_ValueForKey( ui_arenaInfos[n], "special" ), tag ) == 0 ) {
 			return ui_arenaInfos[n];
@@ -359,7 +390,7 @@ static void UI_LoadBots( void ) {
 	vmCvar_t	botsFile;
 	int			numdirs;
 	char		filename[128];
-	char		dirlist[1024];
+	static char	dirlist[20*1024];
 	char*		dirptr;
 	int			i;
 	int			dirlen;
@@ -375,7 +406,7 @@ static void UI_LoadBots( void ) {
 	}
 
 	// get all bots from .bot files
-	numdirs = trap_FS_GetFileList("scripts", ".bot", dirlist, 1024 );
+	numdirs = trap_FS_GetFileList("scripts", ".bot", dirlist, sizeof(dirlist) );
 	dirptr  = dirlist;
 	for (i = 0; i < numdirs; i++, dirptr += dirlen+1) {
 		dirlen = strlen(dirptr);
@@ -384,6 +415,11 @@ static void UI_LoadBots( void ) {
 		UI_LoadBotsFromFile(filename);
 	}
 	trap_Print( va( "%i bots parsed\n", ui_numBots ) );
+
+	BG_InitInfoIndex( &ui_botIndex );
+	for( i = 0; i < ui_numBots; i++ ) {
+		BG_AddToInfoIndex( &ui_botIndex, i, Info_ValueForKey( ui_botInfos[i], "name" ) );
+	}
 }
 
 
@@ -410,6 +446,14 @@ char *UI_GetBotInfoByName( const char *name ) {
 	int		n;
 	char	*value;
 
+	n = BG_FindInInfoIndex( &ui_botIndex, name );
+	if ( n >= 0 ) {
+		return ui_botInfos[n];
+	}
+	if ( !ui_botIndex.overflow ) {
+		return NULL;
+	}
+
 	for ( n = 0; n < ui_numBots ; n++ ) {
 		value = Info_ValueForKey( ui_botInfos[n], "name" );
 		if ( !Q_stricmp( value, name ) ) {
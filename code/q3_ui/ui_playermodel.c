@@ -54,7 +54,7 @@ static char* playermodel_artlist[] =
 #define PLAYERGRID_ROWS		4
 #define MAX_MODELSPERPAGE	(PLAYERGRID_ROWS*PLAYERGRID_COLS)
 
-#define MAX_PLAYERMODELS	256
+#define MAX_PLAYERMODELS	1024
 
 #define ID_PLAYERPIC0		0
 #define ID_PLAYERPIC1		1
@@ -380,6 +380,19 @@ static void PlayerModel_DrawPlayer( void *self )
 	UI_DrawPlayer( b->generic.x, b->generic.y, b->width, b->height, &s_playermodel.playerinfo, uis.realtime/2 );
 }
 
+static modelCatalog_t	s_modelcatalog;
+
+/*
+=================
+PlayerModel_RegisterAnnouncer
+
+com_buildscript has to see the announcer sound of every skin
+=================
+*/
+static void PlayerModel_RegisterAnnouncer( const char *skinname ) {
+	trap_S_RegisterSound( va( "sound/player/announce/%s_wins.wav", skinname), qfalse );
+}
+
 /*
 =================
 PlayerModel_BuildList
@@ -387,60 +400,30 @@ PlayerModel_BuildList
 */
 static void PlayerModel_BuildList( void )
 {
-	int		numdirs;
-	int		numfiles;
-	char	dirlist[2048];
-	char	filelist[2048];
-	char	skinname[MAX_QPATH];
-	char*	dirptr;
-	char*	fileptr;
+	modelCatalog_t	*mc = &s_modelcatalog;
+	catalogDir_t	*dir;
+	qboolean	precache;
 	int		i;
 	int		j;
-	int		dirlen;
-	int		filelen;
-	qboolean precache;
 
+	// every skin has to be seen to register its sounds for precaching
 	precache = trap_Cvar_VariableValue("com_buildscript");
+	BG_SyncModelCatalog( mc, precache, trap_FS_GetFileList, precache ? PlayerModel_RegisterAnnouncer : NULL );
 
 	s_playermodel.modelpage = 0;
 	s_playermodel.nummodels = 0;
 
-	// iterate directory of all player models
-	numdirs = trap_FS_GetFileList("models/players", "/", dirlist, 2048 );
-	dirptr  = dirlist;
-	for (i=0; i<numdirs && s_playermodel.nummodels < MAX_PLAYERMODELS; i++,dirptr+=dirlen+1)
+	for (i=0; i<mc->numOrder && s_playermodel.nummodels < MAX_PLAYERMODELS; i++)
 	{
-		dirlen = strlen(dirptr);
-		
-		if (dirlen && dirptr[dirlen-1]=='/') dirptr[dirlen-1]='\0';
-
-		if (!strcmp(dirptr,".") || !strcmp(dirptr,".."))
-			continue;
-			
-		// iterate all skin files in directory
-		numfiles = trap_FS_GetFileList( va("models/players/%s",dirptr), "tga", filelist, 2048 );
-		fileptr  = filelist;
-		for (j=0; j<numfiles && s_playermodel.nummodels < MAX_PLAYERMODELS;j++,fileptr+=filelen+1)
+		dir = &mc->dirs[mc->order[i]];
+		for (j=0; j<dir->numIcons && s_playermodel.nummodels < MAX_PLAYERMODELS; j++)
 		{
-			filelen = strlen(fileptr);
-
-			COM_StripExtension(fileptr,skinname, sizeof(skinname));
-
-			// look for icon_????
-			if (!Q_stricmpn(skinname,"icon_",5))
-			{
-				Com_sprintf( s_playermodel.modelnames[s_playermodel.nummodels++],
-					sizeof( s_playermodel.modelnames[s_playermodel.nummodels] ),
-					"models/players/%s/%s", dirptr, skinname );
-				//if (s_playermodel.nummodels >= MAX_PLAYERMODELS)
-				//	return;
-			}
-
-			if( precache ) {
-				trap_S_RegisterSound( va( "sound/player/announce/%s_wins.wav", skinname), qfalse );
-			}
+			Com_sprintf( s_playermodel.modelnames[s_playermodel.nummodels],
+				sizeof( s_playermodel.modelnames[s_playermodel.nummodels] ),
+				"models/players/%s/%s", BG_CatalogDirName( mc, dir ), BG_CatalogIconName( mc, dir, j ) );
+			s_playermodel.nummodels++;
 		}
-	}	
+	}
 
 	//APSFIXME - Degenerate no models case
 
@@ -719,8 +702,12 @@ void PlayerModel_Cache( void )
 	}
 
 	PlayerModel_BuildList();
-	for( i = 0; i < s_playermodel.nummodels; i++ ) {
-		trap_R_RegisterShaderNoMip( s_playermodel.modelnames[i] );
+
+	// the grid registers the icons of the page it shows
+	if( trap_Cvar_VariableValue("com_buildscript") ) {
+		for( i = 0; i < s_playermodel.nummodels; i++ ) {
+			trap_R_RegisterShaderNoMip( s_playermodel.modelnames[i] );
+		}
 	}
 }
 
@@ -32,12 +32,16 @@ MULTIPLAYER MENU (SERVER BROWSER)
 #include "ui_local.h"
 
 
-#define MAX_GLOBALSERVERS		256
+#define MAX_GLOBALSERVERS		MAX_GLOBAL_SERVERS
 #define MAX_PINGREQUESTS		32
+#define PING_WINDOW_MIN			4
+#define PING_WINDOW_START		8
+#define PING_LOSS_MARGIN		0.2f
+#define PING_HASH_SIZE			(MAX_GLOBALSERVERS*2)	// power of two
 #define MAX_ADDRESSLENGTH		64
 #define MAX_HOSTNAMELENGTH		31
 #define MAX_MAPNAMELENGTH		20
-#define MAX_LISTBOXITEMS		256
+#define MAX_LISTBOXITEMS		MAX_GLOBALSERVERS
 #define MAX_LOCALSERVERS		124
 #define MAX_STATUSLENGTH		64
 #define MAX_LEAGUELENGTH		28
@@ -184,9 +188,27 @@ static char quake3worldMessage[] = "Visit www.openarena.ws - News, Community, Ev
 
 typedef struct {
 	char	adrstr[MAX_ADDRESSLENGTH];
+	unsigned	hash;
 	int		start;
 } pinglist_t;
 
+// decides which server is pinged next and how many pings are in flight
+typedef struct {
+	int			window;			// pings allowed in flight
+	int			inflight;
+	int			scanned;		// servers looked at so far
+	int			deferred[MAX_GLOBALSERVERS];	// servers to ping after the preferred ones
+	int			numdeferred;
+	int			nextdeferred;
+	int			epochResponses;	// results since the window was last resized
+	int			epochTimeouts;
+	float		timeoutRate;	// running average of the timed out fraction, -1 if unknown
+	qboolean	unsorted;		// results were inserted since the last sort
+	int			seen[PING_HASH_SIZE];		// server number + 1 of every address queued
+	unsigned	seenHash[PING_HASH_SIZE];
+	unsigned	preferred[PING_HASH_SIZE];	// hashes of addresses that passed the filters last time
+} pingscheduler_t;
+
 typedef struct servernode_s {
 	char	adrstr[MAX_ADDRESSLENGTH];
 	char	hostname[MAX_HOSTNAMELENGTH+3];
@@ -255,6 +277,7 @@ typedef struct {
 } arenaservers_t;
 
 static arenaservers_t	g_arenaservers;
+static pingscheduler_t	g_pingscheduler;
 
 
 static servernode_t		g_globalserverlist[MAX_GLOBALSERVERS];
@@ -482,6 +505,110 @@ const char *s;
 }
 
 
+/*
+=================
+ArenaServers_PassesFilters
+=================
+*/
+static qboolean ArenaServers_PassesFilters( servernode_t *servernodeptr ) {
+	// can only cull valid results
+	if( !g_emptyservers && !servernodeptr->numclients ) {
+		return qfalse;
+	}
+
+	//If "Show only humans" and "Hide empty server" are enabled hide servers that only have bots
+	if( !g_emptyservers && g_onlyhumans && !servernodeptr->humanclients ) {
+		return qfalse;
+	}
+
+	if( !g_fullservers && ( servernodeptr->numclients == servernodeptr->maxclients ) ) {
+		return qfalse;
+	}
+
+	switch( g_gametype ) {
+	case GAMES_ALL:
+		break;
+
+	case GAMES_FFA:
+		if( servernodeptr->gametype != GT_FFA ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_TEAMPLAY:
+		if( servernodeptr->gametype != GT_TEAM ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_TOURNEY:
+		if( servernodeptr->gametype != GT_TOURNAMENT ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_CTF:
+		if( servernodeptr->gametype != GT_CTF ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_1FCTF:
+		if( servernodeptr->gametype != GT_1FCTF ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_OBELISK:
+		if( servernodeptr->gametype != GT_OBELISK ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_HARVESTER:
+		if( servernodeptr->gametype != GT_HARVESTER ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_ELIMINATION:
+		if( servernodeptr->gametype != GT_ELIMINATION ) {
+			return qfalse;
+		}
+		break;
+	
+	case GAMES_CTF_ELIMINATION:
+		if( servernodeptr->gametype != GT_CTF_ELIMINATION ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_LMS:
+		if( servernodeptr->gametype != GT_LMS ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_DOUBLE_D:
+		if( servernodeptr->gametype != GT_DOUBLE_D ) {
+			return qfalse;
+		}
+		break;
+
+	case GAMES_DOM:
+		if( servernodeptr->gametype != GT_DOMINATION ) {
+			return qfalse;
+		}
+		break;
+	}
+	
+	if(g_hideprivate && servernodeptr->needPass)
+		return qfalse;
+
+	return qtrue;
+}
+
+
 /*
 =================
 ArenaServers_UpdateMenu
@@ -502,7 +629,10 @@ static void ArenaServers_UpdateMenu( void ) {
 			// show progress
 			Com_sprintf( g_arenaservers.status.string, MAX_STATUSLENGTH, "%d of %d Arena Servers.", g_arenaservers.currentping, g_arenaservers.numqueriedservers);
 			g_arenaservers.statusbar.string  = "Press SPACE to stop";
-			qsort( g_arenaservers.serverlist, *g_arenaservers.numservers, sizeof( servernode_t ), ArenaServers_Compare);
+			if( g_pingscheduler.unsorted ) {
+				qsort( g_arenaservers.serverlist, *g_arenaservers.numservers, sizeof( servernode_t ), ArenaServers_Compare);
+				g_pingscheduler.unsorted = qfalse;
+			}
 		}
 		else {
 			// all servers pinged - enable controls
@@ -592,100 +722,10 @@ static void ArenaServers_UpdateMenu( void ) {
 		tableptr->servernode = servernodeptr;
 		buff = tableptr->buff;
 
-		// can only cull valid results
-		if( !g_emptyservers && !servernodeptr->numclients ) {
-			continue;
-		}
-
-                //If "Show only humans" and "Hide empty server" are enabled hide servers that only have bots
-                if( !g_emptyservers && g_onlyhumans && !servernodeptr->humanclients ) {
-			continue;
-		}
-
-		if( !g_fullservers && ( servernodeptr->numclients == servernodeptr->maxclients ) ) {
+		if( !ArenaServers_PassesFilters( servernodeptr ) ) {
 			continue;
 		}
 
-		switch( g_gametype ) {
-		case GAMES_ALL:
-			break;
-
-		case GAMES_FFA:
-			if( servernodeptr->gametype != GT_FFA ) {
-				continue;
-			}
-			break;
-
-		case GAMES_TEAMPLAY:
-			if( servernodeptr->gametype != GT_TEAM ) {
-				continue;
-			}
-			break;
-
-		case GAMES_TOURNEY:
-			if( servernodeptr->gametype != GT_TOURNAMENT ) {
-				continue;
-			}
-			break;
-
-		case GAMES_CTF:
-			if( servernodeptr->gametype != GT_CTF ) {
-				continue;
-			}
-			break;
-
-                case GAMES_1FCTF:
-			if( servernodeptr->gametype != GT_1FCTF ) {
-				continue;
-			}
-			break;
-
-                case GAMES_OBELISK:
-			if( servernodeptr->gametype != GT_OBELISK ) {
-				continue;
-			}
-			break;
-
-                case GAMES_HARVESTER:
-			if( servernodeptr->gametype != GT_HARVESTER ) {
-				continue;
-			}
-			break;
-
-		case GAMES_ELIMINATION:
-			if( servernodeptr->gametype != GT_ELIMINATION ) {
-				continue;
-			}
-			break;
-		
-		case GAMES_CTF_ELIMINATION:
-			if( servernodeptr->gametype != GT_CTF_ELIMINATION ) {
-				continue;
-			}
-			break;
-
-		case GAMES_LMS:
-			if( servernodeptr->gametype != GT_LMS ) {
-				continue;
-			}
-			break;
-
-		case GAMES_DOUBLE_D:
-			if( servernodeptr->gametype != GT_DOUBLE_D ) {
-				continue;
-			}
-			break;
-
-                case GAMES_DOM:
-			if( servernodeptr->gametype != GT_DOMINATION ) {
-				continue;
-			}
-			break;
-		}
-                
-                if(g_hideprivate && servernodeptr->needPass)
-                    continue;
-
 		if( servernodeptr->pingtime < servernodeptr->minPing ) {
 			pingColor = S_COLOR_BLUE;
 		}
@@ -835,6 +875,8 @@ static void ArenaServers_Insert( char* adrstr, char* info, int pingtime )
 		(*g_arenaservers.numservers)++;
 	}
 
+	g_pingscheduler.unsorted = qtrue;
+
 	Q_strncpyz( servernodeptr->adrstr, adrstr, MAX_ADDRESSLENGTH );
 
 	Q_strncpyz( servernodeptr->hostname, Info_ValueForKey( info, "hostname"), MAX_HOSTNAMELENGTH );
@@ -1032,6 +1074,222 @@ static void ArenaServers_StopRefresh( void )
 }
 
 
+/*
+=============================================================================
+
+PING SCHEDULER
+
+The engine answers at most MAX_PINGREQUESTS pings at once, and a server
+that doesn't answer holds its slot until the max ping runs out.  Servers
+that passed the filters on the last refresh are pinged first, duplicate
+addresses in the master list are skipped, and the number of pings in
+flight follows how many of them get lost: it grows while the timed out
+fraction stays at its usual level, and is halved when it rises above it.
+A steady share of dead servers in the list doesn't shrink the window.
+
+=============================================================================
+*/
+
+/*
+=================
+ArenaServers_HashAddress
+=================
+*/
+static unsigned ArenaServers_HashAddress( const char *adrstr ) {
+	unsigned	hash;
+
+	hash = 2166136261u;
+	while ( *adrstr ) {
+		hash = ( hash ^ (unsigned char)tolower( *adrstr ) ) * 16777619u;
+		adrstr++;
+	}
+
+	// 0 marks an empty slot
+	return hash ? hash : 1;
+}
+
+/*
+=================
+ArenaServers_GetAddress
+=================
+*/
+static void ArenaServers_GetAddress( int server, char *adrstr ) {
+	if (g_servertype == UIAS_FAVORITES) {
+		Q_strncpyz( adrstr, g_arenaservers.favoriteaddresses[server], MAX_ADDRESSLENGTH );
+	} else {
+		trap_LAN_GetServerAddressString( g_servertype, server, adrstr, MAX_ADDRESSLENGTH );
+	}
+}
+
+/*
+=================
+ArenaServers_MarkSeen
+
+Returns qfalse if the address was already queued during this refresh
+=================
+*/
+static qboolean ArenaServers_MarkSeen( int server, const char *adrstr, unsigned hash ) {
+	pingscheduler_t	*ps = &g_pingscheduler;
+	char	other[MAX_ADDRESSLENGTH];
+	int		i;
+
+	for ( i = hash & ( PING_HASH_SIZE - 1 ) ; ps->seen[i] ; i = ( i + 1 ) & ( PING_HASH_SIZE - 1 ) ) {
+		if ( ps->seenHash[i] != hash ) {
+			continue;
+		}
+		ArenaServers_GetAddress( ps->seen[i] - 1, other );
+		if ( !Q_stricmp( other, adrstr ) ) {
+			return qfalse;
+		}
+	}
+
+	ps->seen[i] = server + 1;
+	ps->seenHash[i] = hash;
+	return qtrue;
+}
+
+/*
+=================
+ArenaServers_IsPreferred
+
+A false match only changes the order servers are pinged in
+=================
+*/
+static qboolean ArenaServers_IsPreferred( unsigned hash ) {
+	pingscheduler_t	*ps = &g_pingscheduler;
+	int		i;
+
+	for ( i = hash & ( PING_HASH_SIZE - 1 ) ; ps->preferred[i] ; i = ( i + 1 ) & ( PING_HASH_SIZE - 1 ) ) {
+		if ( ps->preferred[i] == hash ) {
+			return qtrue;
+		}
+	}
+	return qfalse;
+}
+
+/*
+=================
+ArenaServers_InitPingScheduler
+
+Called before the server list is cleared for a new refresh
+=================
+*/
+static void ArenaServers_InitPingScheduler( void ) {
+	pingscheduler_t	*ps = &g_pingscheduler;
+	servernode_t	*servernodeptr;
+	unsigned		hash;
+	int				i, j, maxPing;
+
+	memset( ps, 0, sizeof( *ps ) );
+	ps->window = PING_WINDOW_START;
+	ps->timeoutRate = -1;
+
+	maxPing = ArenaServers_MaxPing();
+	servernodeptr = g_arenaservers.serverlist;
+	for ( i = 0 ; i < *g_arenaservers.numservers ; i++, servernodeptr++ ) {
+		if ( servernodeptr->pingtime >= maxPing || !ArenaServers_PassesFilters( servernodeptr ) ) {
+			continue;
+		}
+		hash = ArenaServers_HashAddress( servernodeptr->adrstr );
+		for ( j = hash & ( PING_HASH_SIZE - 1 ) ; ps->preferred[j] ; j = ( j + 1 ) & ( PING_HASH_SIZE - 1 ) ) {
+			if ( ps->preferred[j] == hash ) {
+				break;
+			}
+		}
+		ps->preferred[j] = hash;
+	}
+}
+
+/*
+=================
+ArenaServers_NextPing
+
+Returns the next server to ping, or -1 if every server found so far is queued
+=================
+*/
+static int ArenaServers_NextPing( char *adrstr, unsigned *hash ) {
+	pingscheduler_t	*ps = &g_pingscheduler;
+	int		server, count;
+
+	count = g_arenaservers.numqueriedservers;
+	if ( count > MAX_GLOBALSERVERS ) {
+		count = MAX_GLOBALSERVERS;
+	}
+
+	while ( ps->scanned < count ) {
+		server = ps->scanned++;
+		ArenaServers_GetAddress( server, adrstr );
+		*hash = ArenaServers_HashAddress( adrstr );
+		if ( !ArenaServers_MarkSeen( server, adrstr, *hash ) ) {
+			// listed twice, counts as done
+			g_arenaservers.currentping++;
+			continue;
+		}
+		if ( ArenaServers_IsPreferred( *hash ) ) {
+			return server;
+		}
+		ps->deferred[ps->numdeferred++] = server;
+	}
+
+	if ( ps->nextdeferred < ps->numdeferred ) {
+		server = ps->deferred[ps->nextdeferred++];
+		ArenaServers_GetAddress( server, adrstr );
+		*hash = ArenaServers_HashAddress( adrstr );
+		return server;
+	}
+
+	return -1;
+}
+
+/*
+=================
+ArenaServers_PingDone
+
+Resizes the window once per window's worth of results
+=================
+*/
+static void ArenaServers_PingDone( qboolean timedout ) {
+	pingscheduler_t	*ps = &g_pingscheduler;
+	float	rate;
+	int		total;
+
+	ps->inflight--;
+	if ( timedout ) {
+		ps->epochTimeouts++;
+	} else {
+		ps->epochResponses++;
+	}
+
+	total = ps->epochResponses + ps->epochTimeouts;
+	if ( total < ps->window ) {
+		return;
+	}
+
+	rate = (float)ps->epochTimeouts / total;
+	if ( ps->timeoutRate >= 0 && rate > ps->timeoutRate + PING_LOSS_MARGIN ) {
+		// more pings than usual went unanswered, they are probably being dropped
+		ps->window /= 2;
+		if ( ps->window < PING_WINDOW_MIN ) {
+			ps->window = PING_WINDOW_MIN;
+		}
+	} else {
+		ps->window += ps->window / 4 + 1;
+		if ( ps->window > MAX_PINGREQUESTS ) {
+			ps->window = MAX_PINGREQUESTS;
+		}
+	}
+
+	if ( ps->timeoutRate < 0 ) {
+		ps->timeoutRate = rate;
+	} else {
+		ps->timeoutRate = ps->timeoutRate * 0.75f + rate * 0.25f;
+	}
+
+	ps->epochResponses = 0;
+	ps->epochTimeouts = 0;
+}
+
+
 /*
 =================
 ArenaServers_DoRefresh
@@ -1039,10 +1297,14 @@ ArenaServers_DoRefresh
 */
 static void ArenaServers_DoRefresh( void )
 {
+	pingscheduler_t	*ps = &g_pingscheduler;
 	int		i;
 	int		j;
 	int		time;
 	int		maxPing;
+	int		found;
+	unsigned	hash;
+	qboolean	exhausted;
 	char	adrstr[MAX_ADDRESSLENGTH];
 	char	info[MAX_INFO_STRING];
 
@@ -1072,53 +1334,62 @@ static void ArenaServers_DoRefresh( void )
 
 	// process ping results
 	maxPing = ArenaServers_MaxPing();
-	for (i=0; i<MAX_PINGREQUESTS; i++)
+	if (ps->inflight || trap_LAN_GetPingQueueCount())
 	{
-		trap_LAN_GetPing( i, adrstr, MAX_ADDRESSLENGTH, &time );
-		if (!adrstr[0])
+		found = 0;
+		for (i=0; i<MAX_PINGREQUESTS && (found < ps->inflight || !ps->inflight); i++)
 		{
-			// ignore empty or pending pings
-			continue;
-		}
+			trap_LAN_GetPing( i, adrstr, MAX_ADDRESSLENGTH, &time );
+			if (!adrstr[0])
+			{
+				// ignore empty or pending pings
+				continue;
+			}
 
-		// find ping result in our local list
-		for (j=0; j<MAX_PINGREQUESTS; j++)
-			if (!Q_stricmp( adrstr, g_arenaservers.pinglist[j].adrstr ))
-				break;
+			// find ping result in our local list
+			hash = ArenaServers_HashAddress( adrstr );
+			for (j=0; j<MAX_PINGREQUESTS; j++)
+				if (g_arenaservers.pinglist[j].hash == hash && !Q_stricmp( adrstr, g_arenaservers.pinglist[j].adrstr ))
+					break;
 
-		if (j < MAX_PINGREQUESTS)
-		{
-			// found it
-			if (!time)
+			if (j < MAX_PINGREQUESTS)
 			{
-				time = uis.realtime - g_arenaservers.pinglist[j].start;
-				if (time < maxPing)
+				// found it
+				found++;
+				if (!time)
 				{
-					// still waiting
-					continue;
+					time = uis.realtime - g_arenaservers.pinglist[j].start;
+					if (time < maxPing)
+					{
+						// still waiting
+						continue;
+					}
 				}
-			}
 
-			if (time > maxPing)
-			{
-				// stale it out
-				info[0] = '\0';
-				time    = maxPing;
-			}
-			else
-			{
-				trap_LAN_GetPingInfo( i, info, MAX_INFO_STRING );
-			}
+				if (time > maxPing)
+				{
+					// stale it out
+					info[0] = '\0';
+					time    = maxPing;
+					ArenaServers_PingDone( qtrue );
+				}
+				else
+				{
+					trap_LAN_GetPingInfo( i, info, MAX_INFO_STRING );
+					ArenaServers_PingDone( qfalse );
+				}
 
-			// insert ping results
-			ArenaServers_Insert( adrstr, info, time );
+				// insert ping results
+				ArenaServers_Insert( adrstr, info, time );
 
-			// clear this query from internal list
-			g_arenaservers.pinglist[j].adrstr[0] = '\0';
-   		}
+				// clear this query from internal list
+				g_arenaservers.pinglist[j].adrstr[0] = '\0';
+				g_arenaservers.pinglist[j].hash = 0;
+			}
 
-		// clear this query from external list
-		trap_LAN_ClearPing( i );
+			// clear this query from external list
+			trap_LAN_ClearPing( i );
+		}
 	}
 
 	// get results of servers query
@@ -1129,12 +1400,9 @@ static void ArenaServers_DoRefresh( void )
 	  g_arenaservers.numqueriedservers = trap_LAN_GetServerCount(g_servertype);
 	}
 
-//	if (g_arenaservers.numqueriedservers > g_arenaservers.maxservers)
-//		g_arenaservers.numqueriedservers = g_arenaservers.maxservers;
-
-	// send ping requests in reasonable bursts
-	// iterate ping through all found servers
-	for (i=0; i<MAX_PINGREQUESTS && g_arenaservers.currentping < g_arenaservers.numqueriedservers; i++)
+	// keep the window full
+	exhausted = qfalse;
+	while (ps->inflight < ps->window)
 	{
 		if (trap_LAN_GetPingQueueCount() >= MAX_PINGREQUESTS)
 		{
@@ -1152,23 +1420,24 @@ static void ArenaServers_DoRefresh( void )
 			break;
 
 		// get an address to ping
-
-		if (g_servertype == UIAS_FAVORITES) {
-		  strcpy( adrstr, g_arenaservers.favoriteaddresses[g_arenaservers.currentping] ); 		
-		} else {
-		  trap_LAN_GetServerAddressString(g_servertype, g_arenaservers.currentping, adrstr, MAX_ADDRESSLENGTH );
+		if (ArenaServers_NextPing( adrstr, &hash ) < 0)
+		{
+			exhausted = qtrue;
+			break;
 		}
 
 		strcpy( g_arenaservers.pinglist[j].adrstr, adrstr );
+		g_arenaservers.pinglist[j].hash  = hash;
 		g_arenaservers.pinglist[j].start = uis.realtime;
 
 		trap_Cmd_ExecuteText( EXEC_NOW, va( "ping %s\n", adrstr )  );
-		
+		ps->inflight++;
+
 		// advance to next server
 		g_arenaservers.currentping++;
 	}
 
-	if (!trap_LAN_GetPingQueueCount())
+	if (exhausted && !ps->inflight)
 	{
 		// all pings completed
 		ArenaServers_StopRefresh();
@@ -1190,11 +1459,15 @@ static void ArenaServers_StartRefresh( void )
 	int		i;
 	char	myargs[32], protocol[32];
 
-	memset( g_arenaservers.serverlist, 0, g_arenaservers.maxservers*sizeof(table_t) );
+	// remember what passed the filters before the results are cleared
+	ArenaServers_InitPingScheduler();
+
+	memset( g_arenaservers.serverlist, 0, g_arenaservers.maxservers*sizeof(servernode_t) );
 
 	for (i=0; i<MAX_PINGREQUESTS; i++)
 	{
 		g_arenaservers.pinglist[i].adrstr[0] = '\0';
+		g_arenaservers.pinglist[i].hash = 0;
 		trap_LAN_ClearPing( i );
 	}
 
@@ -810,6 +810,28 @@ int Q_stricmp (const char *s1, const char *s2) {
 	return (s1 && s2) ? Q_stricmpn (s1, s2, 99999) : -1;
 }
 
+/*
+============
+Q_HashString
+
+Strings that compare equal with Q_stricmp hash the same
+============
+*/
+unsigned int Q_HashString( const char *s ) {
+	unsigned int	hash;
+	int				c;
+
+	hash = 2166136261u;
+	while ( ( c = *s++ ) != 0 ) {
+		if ( c >= 'A' && c <= 'Z' ) {
+			c += 'a' - 'A';
+		}
+		hash ^= (unsigned char)c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
 
 char *Q_strlwr( char *s1 ) {
     char	*s;
@@ -1074,6 +1096,142 @@ char *Info_ValueForKey( const char *s, const char *key ) {
 }
 
 
+/*
+===============
+Info_HashKey
+===============
+*/
+static unsigned Info_HashKey( const char *key ) {
+	unsigned	hash;
+
+	hash = 2166136261u;
+	while ( *key ) {
+		hash = ( hash ^ (unsigned char)tolower( *key ) ) * 16777619u;
+		key++;
+	}
+	return hash;
+}
+
+/*
+===============
+Info_Parse
+
+Splits s into view so Info_ViewValue doesn't have to scan it again.
+The view doesn't point into s unless s is too long to copy.
+===============
+*/
+void Info_Parse( infoView_t *view, const char *s ) {
+	const char	*start;
+	char		*o, *key;
+	unsigned	h;
+	int			i;
+
+	view->src = NULL;
+	view->numKeys = 0;
+
+	if ( !s ) {
+		s = "";
+	}
+	if ( strlen( s ) >= sizeof( view->buf ) ) {
+		view->src = s;
+		return;
+	}
+
+	memset( view->hash, 0, sizeof( view->hash ) );
+
+	start = s;
+
+	if ( *s == '\\' ) {
+		s++;
+	}
+	o = view->buf;
+	while ( *s ) {
+		// key
+		key = o;
+		while ( *s != '\\' ) {
+			if ( !*s ) {
+				// a key without a value is ignored, like in Info_ValueForKey
+				return;
+			}
+			*o++ = *s++;
+		}
+		*o++ = 0;
+		s++;
+
+		// value
+		while ( *s != '\\' && *s ) {
+			*o++ = *s++;
+		}
+		*o++ = 0;
+		if ( *s ) {
+			s++;
+		}
+
+		if ( view->numKeys == INFO_VIEW_KEYS ) {
+			view->src = start;
+			return;
+		}
+
+		// the first of duplicate keys wins
+		if ( view->numKeys >= INFO_VIEW_LINEAR ) {
+			if ( view->numKeys == INFO_VIEW_LINEAR ) {
+				for ( i = 0 ; i < view->numKeys ; i++ ) {
+					h = Info_HashKey( view->buf + view->keys[i] );
+					while ( view->hash[h & ( INFO_VIEW_HASH - 1 )] ) {
+						h++;
+					}
+					view->hash[h & ( INFO_VIEW_HASH - 1 )] = i + 1;
+				}
+			}
+			h = Info_HashKey( key );
+			while ( view->hash[h & ( INFO_VIEW_HASH - 1 )] ) {
+				h++;
+			}
+			view->hash[h & ( INFO_VIEW_HASH - 1 )] = view->numKeys + 1;
+		}
+		view->keys[view->numKeys++] = key - view->buf;
+	}
+}
+
+/*
+===============
+Info_ViewValue
+
+Info_ValueForKey for a parsed infostring.  The value lives in
+the view, so it stays valid as long as the view does.
+===============
+*/
+char *Info_ViewValue( infoView_t *view, const char *key ) {
+	unsigned	h;
+	char		*k;
+	int			i;
+
+	if ( !key ) {
+		return "";
+	}
+	if ( view->src ) {
+		return Info_ValueForKey( view->src, key );
+	}
+
+	if ( view->numKeys <= INFO_VIEW_LINEAR ) {
+		for ( i = 0 ; i < view->numKeys ; i++ ) {
+			k = view->buf + view->keys[i];
+			if ( !Q_stricmp( k, key ) ) {
+				return k + strlen( k ) + 1;
+			}
+		}
+		return "";
+	}
+
+	for ( h = Info_HashKey( key ) ; view->hash[h & ( INFO_VIEW_HASH - 1 )] ; h++ ) {
+		k = view->buf + view->keys[view->hash[h & ( INFO_VIEW_HASH - 1 )] - 1];
+		if ( !Q_stricmp( k, key ) ) {
+			return k + strlen( k ) + 1;
+		}
+	}
+	return "";
+}
+
 /*
 ===================
 Info_NextPair
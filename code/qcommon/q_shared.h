@@ -705,6 +705,8 @@ int		Q_stricmpn (const char *s1, const char *s2, int n);
 char	*Q_strlwr( char *s1 );
 char	*Q_strupr( char *s1 );
 const char	*Q_stristr( const char *s, const char *find);
+// case insensitive FNV-1a hash, mask it with a power of two table size
+unsigned int	Q_HashString( const char *s );
 
 // buffer size safe library replacements
 /**
@@ -791,6 +793,22 @@ void Info_SetValueForKey_Big( char *s, const char *key, const char *value );
 qboolean Info_Validate( const char *s );
 void Info_NextPair( const char **s, char *key, char *value );
 
+// an infostring split up once, for callers that look up many keys
+#define	INFO_VIEW_KEYS		128
+#define	INFO_VIEW_HASH		256		// power of two, hashed above INFO_VIEW_LINEAR keys
+#define	INFO_VIEW_LINEAR	8
+
+typedef struct {
+	const char		*src;					// set if the string didn't fit buf
+	int				numKeys;
+	short			keys[INFO_VIEW_KEYS];	// offsets in buf, each value follows its key
+	unsigned char	hash[INFO_VIEW_HASH];	// 1 + index in keys, 0 for empty
+	char			buf[MAX_INFO_STRING];
+} infoView_t;
+
+void Info_Parse( infoView_t *view, const char *s );
+char *Info_ViewValue( infoView_t *view, const char *key );
+
 // this is only here so the functions in q_shared.c and bg_*.c can link
 void	QDECL Com_Error( int level, const char *error, ... ) __attribute__ ((format (printf, 2, 3))) __attribute__((noreturn));
 void	QDECL Com_Printf( const char *msg, ... ) __attribute__ ((format (printf, 1, 2)));
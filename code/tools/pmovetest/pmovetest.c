@@ -0,0 +1,667 @@
+/*
+===========================================================================
+Copyright (C) 1999-2005 Id Software, Inc.
+
+This file is part of Quake III Arena source code.
+
+Quake III Arena source code is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of the License,
+or (at your option) any later version.
+
+Quake III Arena source code is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Quake III Arena source code; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+===========================================================================
+*/
+//
+// pmovetest.c -- replay a pmoverecord stream through bg_pmove.c natively
+//
+// pmovetest [-g] [-n passes] <world> <recording> <golden>
+//
+// Runs every move of a recording made with the "pmoverecord" server
+// command through Pmove, starting from the recorded playerState, in a
+// world of planes and boxes read from a text file.  The playerState
+// after the last move is compared bit-exact with the golden one, then
+// the whole recording is run the given number of times and the cost
+// per PmoveSingle is printed.  With -g the golden file is written
+// instead of compared, do that before changing the movement code.
+//
+// Build it with the Makefile in this directory, or by hand:
+//
+// cc -O2 -ffp-contract=off -DQAGAME -o pmovetest pmovetest.c ../../game/bg_pmove.c ../../game/bg_slidemove.c ../../game/bg_misc.c ../../qcommon/q_math.c ../../qcommon/q_shared.c -lm
+//
+// test.rec is a scripted tour of test.world: the stairs, the ledge, the
+// ramp, the pillar, the low ceiling and the pool.  Streams captured with
+// pmoverecord run the same way, against a world file that matches the
+// part of the map they were recorded on.
+//
+// test.golden was made by a gcc x86_64 build.  Compilers that round
+// floats differently need their own, made with -g from the tree before
+// the change.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "../../qcommon/q_shared.h"
+#include "../../game/bg_public.h"
+#include "../../game/g_pmoverecord.h"
+
+extern	int		c_pmove;		// bg_pmove.c, counts PmoveSingle calls
+
+// bg_pmove.c reads this cvar of the game, its default is 0
+vmCvar_t	cg_enableQ;
+
+/*
+==============================================================================
+
+WORLD
+
+The world file holds one brush per line, // starts a comment:
+
+plane <contents> <nx> <ny> <nz> <dist>
+	everything behind the plane
+box <contents> <minx> <miny> <minz> <maxx> <maxy> <maxz>
+	an axial box
+cut <nx> <ny> <nz> <dist>
+	cuts the brush before it with one more plane, for ramps
+
+contents is one of solid, playerclip, water, slime, lava or trigger
+
+==============================================================================
+*/
+
+#define	MAX_WORLD_BRUSHES	256
+#define	MAX_BRUSH_PLANES	8
+
+// same as the collision code of the engine
+#define	SURFACE_CLIP_EPSILON	(0.125)
+
+typedef struct {
+	int			contents;
+	int			numPlanes;
+	cplane_t	planes[MAX_BRUSH_PLANES];
+} worldBrush_t;
+
+static worldBrush_t	worldBrushes[MAX_WORLD_BRUSHES];
+static int			numWorldBrushes;
+
+typedef struct {
+	char		*name;
+	int			contents;
+} contentsName_t;
+
+static const contentsName_t	contentsNames[] = {
+	{ "solid",		CONTENTS_SOLID },
+	{ "playerclip",	CONTENTS_PLAYERCLIP },
+	{ "water",		CONTENTS_WATER },
+	{ "slime",		CONTENTS_SLIME },
+	{ "lava",		CONTENTS_LAVA },
+	{ "trigger",	CONTENTS_TRIGGER },
+	{ NULL, 0 }
+};
+
+/*
+==================
+Com_Error
+==================
+*/
+void QDECL Com_Error( int level, const char *error, ... ) {
+	va_list		argptr;
+
+	va_start( argptr, error );
+	vfprintf( stderr, error, argptr );
+	va_end( argptr );
+	fprintf( stderr, "\n" );
+	exit( 1 );
+}
+
+/*
+==================
+Com_Printf
+==================
+*/
+void QDECL Com_Printf( const char *msg, ... ) {
+	va_list		argptr;
+
+	va_start( argptr, msg );
+	vprintf( msg, argptr );
+	va_end( argptr );
+}
+
+/*
+==================
+traps
+
+bg_misc.c and bg_pmove.c call these, there is no engine behind them here
+==================
+*/
+void trap_Cvar_VariableStringBuffer( const char *var_name, char *buffer, int bufsize ) {
+	if ( bufsize > 0 ) {
+		buffer[0] = 0;
+	}
+}
+
+int trap_FS_FOpenFile( const char *qpath, fileHandle_t *f, fsMode_t mode ) {
+	*f = 0;
+	return -1;
+}
+
+void trap_FS_Read( void *buffer, int len, fileHandle_t f ) {
+}
+
+void trap_FS_Write( const void *buffer, int len, fileHandle_t f ) {
+}
+
+void trap_FS_FCloseFile( fileHandle_t f ) {
+}
+
+// the engine rounds to nearest
+void trap_SnapVector( float *v ) {
+	v[0] = rint( v[0] );
+	v[1] = rint( v[1] );
+	v[2] = rint( v[2] );
+}
+
+/*
+==================
+LoadFile
+==================
+*/
+static void *LoadFile( const char *name, int *length ) {
+	FILE	*f;
+	char	*buf;
+	long	len;
+
+	f = fopen( name, "rb" );
+	if ( !f ) {
+		Com_Error( ERR_FATAL, "Couldn't open %s", name );
+	}
+	fseek( f, 0, SEEK_END );
+	len = ftell( f );
+	fseek( f, 0, SEEK_SET );
+	buf = malloc( len + 1 );
+	if ( !buf || fread( buf, 1, len, f ) != (size_t)len ) {
+		Com_Error( ERR_FATAL, "Couldn't read %s", name );
+	}
+	fclose( f );
+	buf[len] = 0;
+	*length = len;
+	return buf;
+}
+
+/*
+==================
+World_ParsePlane
+==================
+*/
+static void World_ParsePlane( char **text, worldBrush_t *b ) {
+	cplane_t	*p;
+	int			i;
+
+	if ( b->numPlanes == MAX_BRUSH_PLANES ) {
+		Com_Error( ERR_FATAL, "MAX_BRUSH_PLANES hit" );
+	}
+	p = &b->planes[b->numPlanes++];
+	for ( i = 0 ; i < 3 ; i++ ) {
+		p->normal[i] = atof( COM_ParseExt( text, qfalse ) );
+	}
+	VectorNormalize( p->normal );
+	p->dist = atof( COM_ParseExt( text, qfalse ) );
+	p->type = PlaneTypeForNormal( p->normal );
+	SetPlaneSignbits( p );
+}
+
+/*
+==================
+World_SetAxialPlane
+==================
+*/
+static void World_SetAxialPlane( worldBrush_t *b, int axis, float sign, float dist ) {
+	cplane_t	*p;
+
+	p = &b->planes[b->numPlanes++];
+	VectorClear( p->normal );
+	p->normal[axis] = sign;
+	p->dist = sign * dist;
+	p->type = sign > 0 ? axis : PLANE_NON_AXIAL;
+	SetPlaneSignbits( p );
+}
+
+/*
+==================
+World_Load
+==================
+*/
+static void World_Load( const char *name ) {
+	char		*buf, *text, *token;
+	worldBrush_t	*b;
+	qboolean	box;
+	vec3_t		mins, maxs;
+	int			i, len;
+
+	buf = LoadFile( name, &len );
+	text = buf;
+	b = NULL;
+	COM_BeginParseSession( name );
+
+	while ( 1 ) {
+		token = COM_Parse( &text );
+		if ( !token[0] ) {
+			break;
+		}
+
+		if ( !Q_stricmp( token, "cut" ) ) {
+			if ( !b ) {
+				Com_Error( ERR_FATAL, "%s: cut without a brush on line %i", name, COM_GetCurrentParseLine() );
+			}
+			World_ParsePlane( &text, b );
+			continue;
+		}
+
+		if ( !Q_stricmp( token, "box" ) ) {
+			box = qtrue;
+		} else if ( !Q_stricmp( token, "plane" ) ) {
+			box = qfalse;
+		} else {
+			Com_Error( ERR_FATAL, "%s: unknown brush type %s on line %i", name, token, COM_GetCurrentParseLine() );
+		}
+
+		if ( numWorldBrushes == MAX_WORLD_BRUSHES ) {
+			Com_Error( ERR_FATAL, "%s: MAX_WORLD_BRUSHES hit", name );
+		}
+		b = &worldBrushes[numWorldBrushes++];
+
+		token = COM_ParseExt( &text, qfalse );
+		for ( i = 0 ; contentsNames[i].name ; i++ ) {
+			if ( !Q_stricmp( token, contentsNames[i].name ) ) {
+				break;
+			}
+		}
+		if ( !contentsNames[i].name ) {
+			Com_Error( ERR_FATAL, "%s: unknown contents %s on line %i", name, token, COM_GetCurrentParseLine() );
+		}
+		b->contents = contentsNames[i].contents;
+
+		if ( !box ) {
+			World_ParsePlane( &text, b );
+			continue;
+		}
+
+		for ( i = 0 ; i < 3 ; i++ ) {
+			mins[i] = atof( COM_ParseExt( &text, qfalse ) );
+		}
+		for ( i = 0 ; i < 3 ; i++ ) {
+			maxs[i] = atof( COM_ParseExt( &text, qfalse ) );
+		}
+		for ( i = 0 ; i < 3 ; i++ ) {
+			World_SetAxialPlane( b, i, 1, maxs[i] );
+			World_SetAxialPlane( b, i, -1, mins[i] );
+		}
+	}
+
+	free( buf );
+	if ( !numWorldBrushes ) {
+		Com_Error( ERR_FATAL, "%s holds no brushes", name );
+	}
+}
+
+/*
+==================
+World_TraceBrush
+
+Clips the move against one brush the way the engine does it,
+every plane is pushed out by the box first
+==================
+*/
+static void World_TraceBrush( trace_t *tr, const worldBrush_t *b, const vec3_t start,
+	const vec3_t mins, const vec3_t maxs, const vec3_t end ) {
+	const cplane_t	*p, *clipplane;
+	vec3_t		offset;
+	float		dist, d1, d2, f;
+	float		enterFrac, leaveFrac;
+	qboolean	getout, startout;
+	int			i, j;
+
+	enterFrac = -1.0;
+	leaveFrac = 1.0;
+	clipplane = NULL;
+	getout = qfalse;
+	startout = qfalse;
+
+	for ( i = 0, p = b->planes ; i < b->numPlanes ; i++, p++ ) {
+		for ( j = 0 ; j < 3 ; j++ ) {
+			offset[j] = p->normal[j] < 0 ? maxs[j] : mins[j];
+		}
+		dist = p->dist - DotProduct( offset, p->normal );
+
+		d1 = DotProduct( start, p->normal ) - dist;
+		d2 = DotProduct( end, p->normal ) - dist;
+
+		if ( d2 > 0 ) {
+			getout = qtrue;		// endpoint is not in solid
+		}
+		if ( d1 > 0 ) {
+			startout = qtrue;
+		}
+
+		// completely in front of face, no intersection with the entire brush
+		if ( d1 > 0 && ( d2 >= SURFACE_CLIP_EPSILON || d2 >= d1 ) ) {
+			return;
+		}
+
+		// if it doesn't cross the plane, the plane isn't relevent
+		if ( d1 <= 0 && d2 <= 0 ) {
+			continue;
+		}
+
+		// crosses face
+		if ( d1 > d2 ) {	// enter
+			f = ( d1 - SURFACE_CLIP_EPSILON ) / ( d1 - d2 );
+			if ( f < 0 ) {
+				f = 0;
+			}
+			if ( f > enterFrac ) {
+				enterFrac = f;
+				clipplane = p;
+			}
+		} else {	// leave
+			f = ( d1 + SURFACE_CLIP_EPSILON ) / ( d1 - d2 );
+			if ( f > 1 ) {
+				f = 1;
+			}
+			if ( f < leaveFrac ) {
+				leaveFrac = f;
+			}
+		}
+	}
+
+	// all planes have been checked, and the trace was not
+	// completely outside the brush
+	if ( !startout ) {	// original point was inside brush
+		tr->startsolid = qtrue;
+		if ( !getout ) {
+			tr->allsolid = qtrue;
+			tr->fraction = 0;
+			tr->contents = b->contents;
+		}
+		return;
+	}
+
+	if ( enterFrac < leaveFrac && enterFrac > -1 && enterFrac < tr->fraction ) {
+		if ( enterFrac < 0 ) {
+			enterFrac = 0;
+		}
+		tr->fraction = enterFrac;
+		tr->plane = *clipplane;
+		tr->contents = b->contents;
+	}
+}
+
+/*
+==================
+World_Trace
+
+pm->trace
+==================
+*/
+static void World_Trace( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs,
+	const vec3_t end, int passEntityNum, int contentMask ) {
+	const worldBrush_t	*b;
+	int			i;
+
+	if ( !mins ) {
+		mins = vec3_origin;
+	}
+	if ( !maxs ) {
+		maxs = vec3_origin;
+	}
+
+	memset( results, 0, sizeof( *results ) );
+	results->fraction = 1;
+	results->entityNum = ENTITYNUM_NONE;
+
+	for ( i = 0, b = worldBrushes ; i < numWorldBrushes ; i++, b++ ) {
+		if ( !( b->contents & contentMask ) ) {
+			continue;
+		}
+		World_TraceBrush( results, b, start, mins, maxs, end );
+		if ( results->allsolid ) {
+			break;
+		}
+	}
+
+	if ( results->fraction == 1 ) {
+		VectorCopy( end, results->endpos );
+	} else {
+		for ( i = 0 ; i < 3 ; i++ ) {
+			results->endpos[i] = start[i] + results->fraction * ( end[i] - start[i] );
+		}
+	}
+	if ( results->fraction != 1 || results->startsolid ) {
+		results->entityNum = ENTITYNUM_WORLD;
+	}
+}
+
+/*
+==================
+World_PointContents
+
+pm->pointcontents
+==================
+*/
+static int World_PointContents( const vec3_t point, int passEntityNum ) {
+	const worldBrush_t	*b;
+	const cplane_t	*p;
+	int			i, j, contents;
+
+	contents = 0;
+	for ( i = 0, b = worldBrushes ; i < numWorldBrushes ; i++, b++ ) {
+		for ( j = 0, p = b->planes ; j < b->numPlanes ; j++, p++ ) {
+			if ( DotProduct( point, p->normal ) - p->dist > 0 ) {
+				break;
+			}
+		}
+		if ( j == b->numPlanes ) {
+			contents |= b->contents;
+		}
+	}
+	return contents;
+}
+
+/*
+==============================================================================
+
+REPLAY
+
+==============================================================================
+*/
+
+static pmoveRecordHeader_t	header;
+static pmoveRecord_t		*records;
+static int					numRecords;
+
+/*
+==================
+Replay_Load
+==================
+*/
+static void Replay_Load( const char *name ) {
+	char	*buf;
+	int		len;
+
+	buf = LoadFile( name, &len );
+	if ( len < (int)sizeof( header ) ) {
+		Com_Error( ERR_FATAL, "%s is not a pmove recording", name );
+	}
+	memcpy( &header, buf, sizeof( header ) );
+	if ( header.ident != PMOVEREC_IDENT || header.version != PMOVEREC_VERSION
+		|| header.recordSize != sizeof( pmoveRecord_t ) ) {
+		Com_Error( ERR_FATAL, "%s is not a pmove recording of this version", name );
+	}
+
+	numRecords = ( len - (int)sizeof( header ) ) / (int)sizeof( pmoveRecord_t );
+	if ( !numRecords ) {
+		Com_Error( ERR_FATAL, "%s holds no moves", name );
+	}
+	records = malloc( numRecords * sizeof( pmoveRecord_t ) );
+	memcpy( records, buf + sizeof( header ), numRecords * sizeof( pmoveRecord_t ) );
+	free( buf );
+}
+
+/*
+==================
+Replay_Run
+
+Runs the whole recording from the recorded start, the result is left in ps
+==================
+*/
+static void Replay_Run( playerState_t *ps ) {
+	const pmoveRecord_t	*rec;
+	pmove_t		pm;
+	int			i;
+
+	*ps = header.start;
+
+	for ( i = 0, rec = records ; i < numRecords ; i++, rec++ ) {
+		memset( &pm, 0, sizeof( pm ) );
+		pm.ps = ps;
+		pm.cmd = rec->cmd;
+		pm.tracemask = rec->tracemask;
+		pm.noFootsteps = rec->noFootsteps;
+		pm.gauntletHit = rec->gauntletHit;
+		pm.pmove_fixed = rec->pmove_fixed;
+		pm.pmove_msec = rec->pmove_msec;
+		pm.pmove_float = rec->pmove_float;
+		pm.pmove_flags = rec->pmove_flags;
+		pm.trace = World_Trace;
+		pm.pointcontents = World_PointContents;
+
+		Pmove( &pm );
+	}
+}
+
+/*
+==================
+Replay_Compare
+
+Bit-exact compare, playerState_t is nothing but ints and floats.
+Returns the index of the first int that differs, or -1.
+==================
+*/
+static int Replay_Compare( const playerState_t *a, const playerState_t *b ) {
+	const int	*ia, *ib;
+	int			i;
+
+	ia = (const int *)a;
+	ib = (const int *)b;
+	for ( i = 0 ; i < sizeof( playerState_t ) / sizeof( int ) ; i++ ) {
+		if ( ia[i] != ib[i] ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+==================
+Sys_Nanoseconds
+==================
+*/
+static double Sys_Nanoseconds( void ) {
+	struct timespec	ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+==================
+main
+==================
+*/
+int main( int argc, char **argv ) {
+	playerState_t	ps, golden;
+	qboolean	writeGolden;
+	FILE		*f;
+	char		*buf;
+	double		start, ns;
+	int			passes, steps, diff;
+	int			i, len;
+
+	writeGolden = qfalse;
+	passes = 100;
+	for ( i = 1 ; i < argc && argv[i][0] == '-' ; i++ ) {
+		if ( !strcmp( argv[i], "-g" ) ) {
+			writeGolden = qtrue;
+		} else if ( !strcmp( argv[i], "-n" ) && i + 1 < argc ) {
+			passes = atoi( argv[++i] );
+			if ( passes < 1 ) {
+				passes = 1;
+			}
+		} else {
+			break;
+		}
+	}
+	if ( argc - i != 3 ) {
+		printf( "usage: pmovetest [-g] [-n passes] <world> <recording> <golden>\n" );
+		return 1;
+	}
+
+	World_Load( argv[i] );
+	Replay_Load( argv[i+1] );
+
+	steps = c_pmove;
+	Replay_Run( &ps );
+	steps = c_pmove - steps;
+
+	printf( "%s: %i brushes\n", argv[i], numWorldBrushes );
+	printf( "%s: %i moves recorded on %s, %i PmoveSingle\n", argv[i+1], numRecords, header.mapname, steps );
+
+	if ( writeGolden ) {
+		f = fopen( argv[i+2], "wb" );
+		if ( !f || fwrite( &ps, sizeof( ps ), 1, f ) != 1 ) {
+			Com_Error( ERR_FATAL, "Couldn't write %s", argv[i+2] );
+		}
+		fclose( f );
+		printf( "%s written\n", argv[i+2] );
+		return 0;
+	}
+
+	buf = LoadFile( argv[i+2], &len );
+	if ( len != sizeof( golden ) ) {
+		Com_Error( ERR_FATAL, "%s is not a playerState of this version", argv[i+2] );
+	}
+	memcpy( &golden, buf, sizeof( golden ) );
+	free( buf );
+
+	diff = Replay_Compare( &ps, &golden );
+	if ( diff != -1 ) {
+		printf( "FAILED: the final playerState differs from %s at byte %i\n", argv[i+2], diff * (int)sizeof( int ) );
+		printf( "  golden   origin (%f %f %f) velocity (%f %f %f)\n", golden.origin[0], golden.origin[1], golden.origin[2],
+			golden.velocity[0], golden.velocity[1], golden.velocity[2] );
+		printf( "  replayed origin (%f %f %f) velocity (%f %f %f)\n", ps.origin[0], ps.origin[1], ps.origin[2],
+			ps.velocity[0], ps.velocity[1], ps.velocity[2] );
+		return 1;
+	}
+	printf( "final playerState matches %s\n", argv[i+2] );
+
+	// time the whole recording
+	start = Sys_Nanoseconds();
+	for ( i = 0 ; i < passes ; i++ ) {
+		Replay_Run( &ps );
+	}
+	ns = Sys_Nanoseconds() - start;
+
+	printf( "%i passes in %.1f msec, %.1f ns per PmoveSingle\n", passes, ns / 1e6, ns / ( (double)steps * passes ) );
+	return 0;
+}
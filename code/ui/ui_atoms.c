@@ -335,6 +335,16 @@ qboolean UI_ConsoleCommand( int realTime ) {
 		UI_Report();
 		return qtrue;
 	}
+
+	if ( Q_stricmp (cmd, "ui_stringstats") == 0 ) {
+		String_Stats();
+		return qtrue;
+	}
+
+	if ( Q_stricmp (cmd, "ui_paintstats") == 0 ) {
+		Paint_Stats();
+		return qtrue;
+	}
 	
 	if ( Q_stricmp (cmd, "ui_load") == 0 ) {
 		UI_Load();
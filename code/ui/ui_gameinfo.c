@@ -34,6 +34,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 int				ui_numBots;
 static char		*ui_botInfos[MAX_BOTS];
+static infoIndex_t	ui_botIndex;		// by name
 
 static int		ui_numArenas;
 static char		*ui_arenaInfos[MAX_ARENAS];
@@ -136,7 +137,7 @@ void UI_LoadArenas( void ) {
 	int			numdirs;
 	vmCvar_t	arenasFile;
 	char		filename[128];
-	char		dirlist[1024];
+	static char	dirlist[20*1024];
 	char*		dirptr;
 	int			i, n;
 	int			dirlen;
@@ -158,7 +159,7 @@ void UI_LoadArenas( void ) {
 	}
 
 	// get all arenas from .arena files
-	numdirs = trap_FS_GetFileList("scripts", ".arena", dirlist, 1024 );
+	numdirs = trap_FS_GetFileList("scripts", ".arena", dirlist, sizeof(dirlist) );
 	dirptr  = dirlist;
 	for (i = 0; i < numdirs; i++, dirptr += dirlen+1) {
 		dirlen = strlen(dirptr);
@@ -281,7 +282,7 @@ void UI_LoadBots( void ) {
 	vmCvar_t	botsFile;
 	int			numdirs;
 	char		filename[128];
-	char		dirlist[1024];
+	static char	dirlist[20*1024];
 	char*		dirptr;
 	int			i;
 	int			dirlen;
@@ -297,7 +298,7 @@ void UI_LoadBots( void ) {
 	}
 
 	// get all bots from .bot files
-	numdirs = trap_FS_GetFileList("scripts", ".bot", dirlist, 1024 );
+	numdirs = trap_FS_GetFileList("scripts", ".bot", dirlist, sizeof(dirlist) );
 	dirptr  = dirlist;
 	for (i = 0; i < numdirs; i++, dirptr += dirlen+1) {
 		dirlen = strlen(dirptr);
@@ -306,6 +307,11 @@ void UI_LoadBots( void ) {
 		UI_LoadBotsFromFile(filename);
 	}
 	trap_Print( va( "%i bots parsed\n", ui_numBots ) );
+
+	BG_InitInfoIndex( &ui_botIndex );
+	for( i = 0; i < ui_numBots; i++ ) {
+		BG_AddToInfoIndex( &ui_botIndex, i, Info_ValueForKey( ui_botInfos[i], "name" ) );
+	}
 }
 
 
@@ -332,6 +338,14 @@ char *UI_GetBotInfoByName( const char *name ) {
 	int		n;
 	char	*value;
 
+	n = BG_FindInInfoIndex( &ui_botIndex, name );
+	if ( n >= 0 ) {
+		return ui_botInfos[n];
+	}
+	if ( !ui_botIndex.overflow ) {
+		return NULL;
+	}
+
 	for ( n = 0; n < ui_numBots ; n++ ) {
 		value = Info_ValueForKey( ui_botInfos[n], "name" );
 		if ( !Q_stricmp( value, name ) ) {
@@ -348,8 +362,13 @@ int UI_GetNumBots( void ) {
 
 
 char *UI_GetBotNameByNumber( int num ) {
+	const char *name;
 	char *info = UI_GetBotInfoByNumber(num);
 	if (info) {
+		name = BG_InfoIndexValue( &ui_botIndex, num );
+		if (name) {
+			return (char *)name;
+		}
 		return Info_ValueForKey( info, "name" );
 	}
 	return "Sarge";
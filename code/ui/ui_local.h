@@ -1059,6 +1059,14 @@ void			trap_R_AddLightToScene( const vec3_t org, float intensity, float r, float
 void			trap_R_RenderScene( const refdef_t *fd );
 void			trap_R_SetColor( const float *rgba );
 void			trap_R_DrawStretchPic( float x, float y, float w, float h, float s1, float t1, float s2, float t2, qhandle_t hShader );
+
+// feed the paint cache in ui_shared.c, this has to happen here rather
+// than in ui_syscalls.c so it also works for qvms
+#define trap_R_SetColor(rgba) \
+	( Paint_TrackColor(rgba), trap_R_SetColor(rgba) )
+#define trap_R_DrawStretchPic(x,y,w,h,s1,t1,s2,t2,sh) \
+	( ( paintRecording ? Paint_RecordStretchPic(x,y,w,h,s1,t1,s2,t2,sh) : (void)0 ), \
+	trap_R_DrawStretchPic(x,y,w,h,s1,t1,s2,t2,sh) )
 void			trap_R_ModelBounds( clipHandle_t model, vec3_t mins, vec3_t maxs );
 void			trap_UpdateScreen( void );
 int				trap_CM_LerpTag( orientation_t *tag, clipHandle_t mod, int startFrame, int endFrame, float frac, const char *tagName );
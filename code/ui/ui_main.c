@@ -146,7 +146,7 @@ static void UI_FeederSelection(float feederID, int index);
 static void UI_BuildServerDisplayList(qboolean force);
 static void UI_BuildServerStatus(qboolean force);
 static void UI_BuildFindPlayerList(qboolean force);
-static int QDECL UI_ServersQsortCompare( const void *arg1, const void *arg2 );
+static int UI_CompareServers( int s1, int s2 );
 static int UI_MapCountByGameType(qboolean singlePlayer);
 static int UI_HeadCountByTeam( void );
 static void UI_ParseGameInfo(const char *teamFile);
@@ -166,6 +166,9 @@ This must be the very first function compiled into the .qvm file
 ================
 */
 vmCvar_t  ui_new;
+vmCvar_t  ui_menuCache;
+vmCvar_t  ui_stringPoolSize;
+vmCvar_t  ui_paintCache;
 vmCvar_t  ui_leidebug;
 vmCvar_t  ui_debug;
 vmCvar_t  ui_initialized;
@@ -709,6 +712,8 @@ void _UI_Refresh( int realtime )
 	uiInfo.uiDC.frameTime = realtime - uiInfo.uiDC.realTime;
 	uiInfo.uiDC.realTime = realtime;
 
+	Display_UpdateCvarWatches();
+
 	previousTimes[index % UI_FPS_FRAMES] = uiInfo.uiDC.frameTime;
 	index++;
 	if ( index > UI_FPS_FRAMES ) {
@@ -1245,6 +1250,13 @@ void UI_Report( void ) {
 void UI_ParseMenu(const char *menuFile) {
 	int handle;
 	pc_token_t token;
+	int firstMenu;
+	qboolean assets;
+
+	if (ui_menuCache.integer && Menu_LoadCache(menuFile)) {
+		Com_Printf("Loaded cached menu file:%s\n", menuFile);
+		return;
+	}
 
 	Com_Printf("Parsing menu file:%s\n", menuFile);
 
@@ -1253,6 +1265,9 @@ void UI_ParseMenu(const char *menuFile) {
 		return;
 	}
 
+	firstMenu = Menu_Count();
+	assets = qfalse;
+
 	while ( 1 ) {
 		memset(&token, 0, sizeof(pc_token_t));
 		if (!trap_PC_ReadToken( handle, &token )) {
@@ -1274,6 +1289,7 @@ void UI_ParseMenu(const char *menuFile) {
 		}
 
 		if (Q_stricmp(token.string, "assetGlobalDef") == 0) {
+			assets = qtrue;
 			if (Asset_Parse(handle)) {
 				continue;
 			} else {
@@ -1287,6 +1303,11 @@ void UI_ParseMenu(const char *menuFile) {
 		}
 	}
 	trap_PC_FreeSource(handle);
+
+	// the assets aren't cached, so files defining them are always parsed
+	if (ui_menuCache.integer && !assets) {
+		Menu_SaveCache(menuFile, firstMenu);
+	}
 }
 
 qboolean Load_Menu(int handle) {
@@ -2806,6 +2827,79 @@ static void UI_OwnerDraw(float x, float y, float w, float h, float text_x, float
 // end changed RD
 }
 
+/*
+=================
+UI_OwnerDrawDeps
+
+What an owner draw reads, for the paint cache.  Owner draws that are
+not listed here are drawn every frame.
+=================
+*/
+static qboolean UI_OwnerDrawDeps(int ownerDraw, int *key, const char **cvar) {
+	*key = 0;
+	*cvar = NULL;
+
+	switch (ownerDraw) {
+		case UI_HANDICAP:
+			*cvar = "handicap";
+			break;
+		case UI_CLANNAME:
+			*cvar = "ui_teamName";
+			break;
+		case UI_GAMETYPE:
+			*cvar = "ui_gameType";
+			break;
+		case UI_NETGAMETYPE:
+			*cvar = "ui_netGameType";
+			break;
+		case UI_JOINGAMETYPE:
+			*cvar = "ui_joinGameType";
+			break;
+		case UI_SKILL:
+			*cvar = "g_spSkill";
+			break;
+		case UI_BLUETEAMNAME:
+			*cvar = "ui_blueTeam";
+			break;
+		case UI_REDTEAMNAME:
+			*cvar = "ui_redTeam";
+			break;
+		case UI_NETSOURCE:
+			*cvar = "ui_netSource";
+			break;
+		case UI_NETFILTER:
+			*cvar = "ui_serverFilterType";
+			break;
+		case UI_TIER:
+			*cvar = "ui_currentTier";
+			break;
+		case UI_BOTNAME:
+			*cvar = "g_gametype";
+			*key = uiInfo.botIndex;
+			break;
+		case UI_BOTSKILL:
+			*key = uiInfo.skillIndex;
+			break;
+		case UI_REDBLUE:
+			*key = uiInfo.redBlue;
+			break;
+		case UI_CROSSHAIR:
+			*key = uiInfo.currentCrosshair;
+			break;
+		case UI_NETMAPPREVIEW:
+			*key = uiInfo.serverStatus.currentServerPreview;
+			break;
+		case UI_KEYBINDSTATUS:
+			*key = Display_KeyBindPending();
+			break;
+		case UI_GLINFO:
+			break;
+		default:
+			return qfalse;
+	}
+	return qtrue;
+}
+
 static qboolean UI_OwnerDrawVisible(int flags) {
 	qboolean vis = qtrue;
 
@@ -3426,13 +3520,40 @@ static float UI_GetValue(int ownerDraw) {
 
 /*
 =================
-UI_ServersQsortCompare
+UI_MergeSortServers
+
+Stable, and compares in the module instead of through the LAN syscalls
 =================
 */
-static int QDECL UI_ServersQsortCompare( const void *arg1, const void *arg2 ) {
-	return trap_LAN_CompareServers( ui_netSource.integer, uiInfo.serverStatus.sortKey, uiInfo.serverStatus.sortDir, *(int*)arg1, *(int*)arg2);
-}
+static void UI_MergeSortServers( int *list, int *temp, int count ) {
+	int half, i, j, k;
+
+	if ( count < 2 ) {
+		return;
+	}
 
+	half = count / 2;
+	UI_MergeSortServers( list, temp, half );
+	UI_MergeSortServers( list + half, temp, count - half );
+
+	i = 0;
+	j = half;
+	k = 0;
+	while ( i < half && j < count ) {
+		if ( UI_CompareServers( list[j], list[i] ) < 0 ) {
+			temp[k++] = list[j++];
+		} else {
+			temp[k++] = list[i++];
+		}
+	}
+	while ( i < half ) {
+		temp[k++] = list[i++];
+	}
+	while ( j < count ) {
+		temp[k++] = list[j++];
+	}
+	memcpy( list, temp, count * sizeof( int ) );
+}
 
 /*
 =================
@@ -3440,6 +3561,7 @@ UI_ServersSort
 =================
 */
 void UI_ServersSort(int column, qboolean force) {
+	static int	temp[MAX_DISPLAY_SERVERS];
 
 	if ( !force ) {
 		if ( uiInfo.serverStatus.sortKey == column ) {
@@ -3448,7 +3570,7 @@ void UI_ServersSort(int column, qboolean force) {
 	}
 
 	uiInfo.serverStatus.sortKey = column;
-	qsort( &uiInfo.serverStatus.displayServers[0], uiInfo.serverStatus.numDisplayServers, sizeof(int), UI_ServersQsortCompare);
+	UI_MergeSortServers( uiInfo.serverStatus.displayServers, temp, uiInfo.serverStatus.numDisplayServers );
 }
 
 /*
@@ -4657,6 +4779,153 @@ static int UI_HeadCountByTeam(void) {
 	return c;
 }
 
+/*
+=============================================================================
+
+SERVER INDEX
+
+The parts of the server infos the browser filters and sorts on.  An
+entry is only read again when the ping of its server changes, so
+rebuilding the display list after a filter change and sorting it don't
+fetch and parse info strings or go through trap_LAN_CompareServers for
+every comparison.
+
+=============================================================================
+*/
+
+typedef struct {
+	int		source;									// ui_netSource the entries are for
+	qboolean	valid[MAX_GLOBAL_SERVERS];
+	int		ping[MAX_GLOBAL_SERVERS];				// ping the entry was read at
+	short	clients[MAX_GLOBAL_SERVERS];
+	short	humans[MAX_GLOBAL_SERVERS];
+	short	maxClients[MAX_GLOBAL_SERVERS];
+	short	gameType[MAX_GLOBAL_SERVERS];
+	char	hostName[MAX_GLOBAL_SERVERS][MAX_NAME_LENGTH];	// without color codes
+	char	mapName[MAX_GLOBAL_SERVERS][MAX_NAME_LENGTH];
+	char	game[MAX_GLOBAL_SERVERS][MAX_NAME_LENGTH];
+} serverIndex_t;
+
+static serverIndex_t	uiServerIndex;
+
+/*
+==================
+UI_ClearServerIndex
+==================
+*/
+static void UI_ClearServerIndex( void ) {
+	memset( uiServerIndex.valid, 0, sizeof( uiServerIndex.valid ) );
+	uiServerIndex.source = ui_netSource.integer;
+}
+
+/*
+==================
+UI_UpdateServerIndex
+==================
+*/
+static void UI_UpdateServerIndex( int num, int ping ) {
+	char	info[MAX_STRING_CHARS];
+
+	if ( uiServerIndex.source != ui_netSource.integer ) {
+		UI_ClearServerIndex();
+	}
+	if ( uiServerIndex.valid[num] && uiServerIndex.ping[num] == ping ) {
+		return;
+	}
+
+	trap_LAN_GetServerInfo( ui_netSource.integer, num, info, sizeof( info ) );
+	uiServerIndex.valid[num] = qtrue;
+	uiServerIndex.ping[num] = ping;
+	uiServerIndex.clients[num] = atoi( Info_ValueForKey( info, "clients" ) );
+	uiServerIndex.humans[num] = atoi( Info_ValueForKey( info, "g_humanplayers" ) );
+	uiServerIndex.maxClients[num] = atoi( Info_ValueForKey( info, "sv_maxclients" ) );
+	uiServerIndex.gameType[num] = atoi( Info_ValueForKey( info, "gametype" ) );
+	Q_strncpyz( uiServerIndex.hostName[num], Info_ValueForKey( info, "hostname" ), MAX_NAME_LENGTH );
+	Q_CleanStr( uiServerIndex.hostName[num] );
+	Q_strncpyz( uiServerIndex.mapName[num], Info_ValueForKey( info, "mapname" ), MAX_NAME_LENGTH );
+	Q_strncpyz( uiServerIndex.game[num], Info_ValueForKey( info, "game" ), MAX_NAME_LENGTH );
+}
+
+/*
+==================
+UI_CompareServerKey
+
+Same order as trap_LAN_CompareServers in ascending direction
+==================
+*/
+static int UI_CompareServerKey( int key, int s1, int s2 ) {
+	int		v1, v2;
+
+	switch ( key ) {
+	case SORT_HOST:
+		return Q_stricmp( uiServerIndex.hostName[s1], uiServerIndex.hostName[s2] );
+	case SORT_MAP:
+		return Q_stricmp( uiServerIndex.mapName[s1], uiServerIndex.mapName[s2] );
+	case SORT_CLIENTS:
+		v1 = uiServerIndex.clients[s1];
+		v2 = uiServerIndex.clients[s2];
+		break;
+	case SORT_GAME:
+		v1 = uiServerIndex.gameType[s1];
+		v2 = uiServerIndex.gameType[s2];
+		break;
+	case SORT_PING:
+		v1 = uiServerIndex.ping[s1];
+		v2 = uiServerIndex.ping[s2];
+		break;
+	default:
+		return 0;
+	}
+
+	if ( v1 < v2 ) {
+		return -1;
+	}
+	if ( v1 > v2 ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+==================
+UI_CompareServers
+
+Sorts on the selected column, then on the other columns in ascending
+order, then on the server number, so it only returns 0 for the same
+server and the order never depends on the order servers came in.
+==================
+*/
+static int UI_CompareServers( int s1, int s2 ) {
+	static const int tieKeys[] = { SORT_HOST, SORT_MAP, SORT_CLIENTS, SORT_GAME, SORT_PING };
+	int		i, res;
+
+	res = UI_CompareServerKey( uiInfo.serverStatus.sortKey, s1, s2 );
+	if ( uiInfo.serverStatus.sortDir ) {
+		res = -res;
+	}
+	if ( res ) {
+		return res;
+	}
+
+	for ( i = 0 ; i < sizeof( tieKeys ) / sizeof( tieKeys[0] ) ; i++ ) {
+		if ( tieKeys[i] == uiInfo.serverStatus.sortKey ) {
+			continue;
+		}
+		res = UI_CompareServerKey( tieKeys[i], s1, s2 );
+		if ( res ) {
+			return res;
+		}
+	}
+
+	if ( s1 < s2 ) {
+		return -1;
+	}
+	if ( s1 > s2 ) {
+		return 1;
+	}
+	return 0;
+}
+
 /*
 ==================
 UI_InsertServerIntoDisplayList
@@ -4668,12 +4937,15 @@ static void UI_InsertServerIntoDisplayList(int num, int position) {
 	if (position < 0 || position > uiInfo.serverStatus.numDisplayServers ) {
 		return;
 	}
+	if (uiInfo.serverStatus.numDisplayServers >= MAX_DISPLAY_SERVERS) {
+		return;
+	}
 	//
-	uiInfo.serverStatus.numDisplayServers++;
 	for (i = uiInfo.serverStatus.numDisplayServers; i > position; i--) {
 		uiInfo.serverStatus.displayServers[i] = uiInfo.serverStatus.displayServers[i-1];
 	}
 	uiInfo.serverStatus.displayServers[position] = num;
+	uiInfo.serverStatus.numDisplayServers++;
 }
 
 /*
@@ -4711,8 +4983,7 @@ static void UI_BinaryServerInsertion(int num) {
 	while(mid > 0) {
 		mid = len >> 1;
 		//
-		res = trap_LAN_CompareServers( ui_netSource.integer, uiInfo.serverStatus.sortKey,
-					uiInfo.serverStatus.sortDir, num, uiInfo.serverStatus.displayServers[offset+mid]);
+		res = UI_CompareServers( num, uiInfo.serverStatus.displayServers[offset+mid] );
 		// if equal
 		if (res == 0) {
 			UI_InsertServerIntoDisplayList(num, offset+mid);
@@ -4741,7 +5012,8 @@ UI_BuildServerDisplayList
 */
 static void UI_BuildServerDisplayList(qboolean force) {
 	int i, count, clients, maxClients, ping, game, len, visible;
-	char info[MAX_STRING_CHARS];
+	qboolean humansOnly;
+	char customServer[MAX_CVAR_VALUE_STRING];
 //	qboolean startRefresh = qtrue; TTimo: unused
 	static int numinvisible;
 
@@ -4786,6 +5058,13 @@ static void UI_BuildServerDisplayList(qboolean force) {
 		return;
 	}
 
+	if (count > MAX_GLOBAL_SERVERS) {
+		count = MAX_GLOBAL_SERVERS;
+	}
+
+	humansOnly = trap_Cvar_VariableValue("ui_humansonly") != 0;
+	trap_Cvar_VariableStringBuffer("ui_CustomServer", customServer, sizeof(customServer));
+
 	visible = qfalse;
 	for (i = 0; i < count; i++) {
 		// if we already got info for this server
@@ -4797,12 +5076,12 @@ static void UI_BuildServerDisplayList(qboolean force) {
 		ping = trap_LAN_GetServerPing(ui_netSource.integer, i);
 		if (ping > 0 || ui_netSource.integer == AS_FAVORITES) {
 
-			trap_LAN_GetServerInfo(ui_netSource.integer, i, info, MAX_STRING_CHARS);
+			UI_UpdateServerIndex(i, ping);
 
-                        if(trap_Cvar_VariableValue("ui_humansonly"))
-                            clients = atoi(Info_ValueForKey(info, "g_humanplayers"));
+                        if(humansOnly)
+                            clients = uiServerIndex.humans[i];
                         else
-                            clients = atoi(Info_ValueForKey(info, "clients"));
+                            clients = uiServerIndex.clients[i];
 			uiInfo.serverStatus.numPlayersOnServers += clients;
 
 			if (ui_browserShowEmpty.integer == 0) {
@@ -4813,7 +5092,7 @@ static void UI_BuildServerDisplayList(qboolean force) {
 			}
 
 			if (ui_browserShowFull.integer == 0) {
-				maxClients = atoi(Info_ValueForKey(info, "sv_maxclients"));
+				maxClients = uiServerIndex.maxClients[i];
 				if (clients == maxClients) {
 					trap_LAN_MarkServerVisible(ui_netSource.integer, i, qfalse);
 					continue;
@@ -4821,7 +5100,7 @@ static void UI_BuildServerDisplayList(qboolean force) {
 			}
 
 			if (uiInfo.joinGameTypes[ui_joinGameType.integer].gtEnum != -1) {
-				game = atoi(Info_ValueForKey(info, "gametype"));
+				game = uiServerIndex.gameType[i];
 				if (game != uiInfo.joinGameTypes[ui_joinGameType.integer].gtEnum) {
 					trap_LAN_MarkServerVisible(ui_netSource.integer, i, qfalse);
 					continue;
@@ -4829,14 +5108,14 @@ static void UI_BuildServerDisplayList(qboolean force) {
 			}
 				
 			if (ui_serverFilterType.integer > 0) {
-				if (Q_stricmp(Info_ValueForKey(info, "game"), serverFilters[ui_serverFilterType.integer].basedir) != 0) {
+				if (Q_stricmp(uiServerIndex.game[i], serverFilters[ui_serverFilterType.integer].basedir) != 0) {
 					trap_LAN_MarkServerVisible(ui_netSource.integer, i, qfalse);
 					continue;
 				}
 			}
 			// Changed RD
 			else {
-				if (Q_stricmp(Info_ValueForKey(info, "game"), UI_Cvar_VariableString("ui_CustomServer")) != 0) {
+				if (Q_stricmp(uiServerIndex.game[i], customServer) != 0) {
 					trap_LAN_MarkServerVisible(ui_netSource.integer, i, qfalse);
 					continue;
 				}
@@ -5305,9 +5584,11 @@ static void UI_UpdatePendingPings( void ) {
 
 static const char *UI_FeederItemText(float feederID, int index, int column, qhandle_t *handle) {
 	static char info[MAX_STRING_CHARS];
+	static infoView_t serverInfo;
 	static char hostname[1024];
 	static char clientBuff[32];
-	static int lastColumn = -1;
+	static int lastSource = -1;
+	static int lastServer = -1;
 	static int lastTime = 0;
 	*handle = -1;
 	if (feederID == FEEDER_HEADS) {
@@ -5326,13 +5607,18 @@ static const char *UI_FeederItemText(float feederID, int index, int column, qhan
 		return UI_SelectedMap(index, &actual);
 	} else if (feederID == FEEDER_SERVERS) {
 		if (index >= 0 && index < uiInfo.serverStatus.numDisplayServers) {
-			int ping, game;
-			if (lastColumn != column || lastTime > uiInfo.uiDC.realTime + 5000) {
-				trap_LAN_GetServerInfo(ui_netSource.integer, uiInfo.serverStatus.displayServers[index], info, MAX_STRING_CHARS);
-				lastColumn = column;
+			int ping, game, server;
+			// the list box asks for each column of a row in turn,
+			// so only fetch and split the info once per row and frame
+			server = uiInfo.serverStatus.displayServers[index];
+			if (server != lastServer || ui_netSource.integer != lastSource || uiInfo.uiDC.realTime != lastTime) {
+				trap_LAN_GetServerInfo(ui_netSource.integer, server, info, MAX_STRING_CHARS);
+				Info_Parse(&serverInfo, info);
+				lastServer = server;
+				lastSource = ui_netSource.integer;
 				lastTime = uiInfo.uiDC.realTime;
 			}
-			ping = atoi(Info_ValueForKey(info, "ping"));
+			ping = atoi(Info_ViewValue(&serverInfo, "ping"));
 			if (ping == -1) {
 				// if we ever see a ping that is out of date, do a server refresh
 				// UI_UpdatePendingPings();
@@ -5340,25 +5626,25 @@ static const char *UI_FeederItemText(float feederID, int index, int column, qhan
 			switch (column) {
 				case SORT_HOST : 
 					if (ping <= 0) {
-						return Info_ValueForKey(info, "addr");
+						return Info_ViewValue(&serverInfo, "addr");
 					} else {
 						if ( ui_netSource.integer == AS_LOCAL ) {
 							Com_sprintf( hostname, sizeof(hostname), "%s [%s]",
-											Info_ValueForKey(info, "hostname"),
-											netnames[atoi(Info_ValueForKey(info, "nettype"))] );
+											Info_ViewValue(&serverInfo, "hostname"),
+											netnames[atoi(Info_ViewValue(&serverInfo, "nettype"))] );
 							return hostname;
 						}
 						else {
-							Com_sprintf( hostname, sizeof(hostname), "%s", Info_ValueForKey(info, "hostname"));
+							Com_sprintf( hostname, sizeof(hostname), "%s", Info_ViewValue(&serverInfo, "hostname"));
 							return hostname;
 						}
 					}
-				case SORT_MAP : return Info_ValueForKey(info, "mapname");
+				case SORT_MAP : return Info_ViewValue(&serverInfo, "mapname");
 				case SORT_CLIENTS : 
-					Com_sprintf( clientBuff, sizeof(clientBuff), "%s (%s)", trap_Cvar_VariableValue("ui_humansonly")? Info_ValueForKey(info, "g_humanplayers") : Info_ValueForKey(info, "clients"), Info_ValueForKey(info, "sv_maxclients"));
+					Com_sprintf( clientBuff, sizeof(clientBuff), "%s (%s)", trap_Cvar_VariableValue("ui_humansonly")? Info_ViewValue(&serverInfo, "g_humanplayers") : Info_ViewValue(&serverInfo, "clients"), Info_ViewValue(&serverInfo, "sv_maxclients"));
 					return clientBuff;
 				case SORT_GAME : 
-					game = atoi(Info_ValueForKey(info, "gametype"));
+					game = atoi(Info_ViewValue(&serverInfo, "gametype"));
 					if (game >= 0 && game < numTeamArenaGameTypes) {
 						return teamArenaGameTypes[game];
 					} else {
@@ -5368,7 +5654,7 @@ static const char *UI_FeederItemText(float feederID, int index, int column, qhan
 					if (ping <= 0) {
 						return "...";
 					} else {
-						return Info_ValueForKey(info, "ping");
+						return Info_ViewValue(&serverInfo, "ping");
 					}
 			}
 		}
@@ -5412,6 +5698,28 @@ static const char *UI_FeederItemText(float feederID, int index, int column, qhan
 }
 
 
+/*
+=================
+UI_Q3HeadIcon
+=================
+*/
+static qhandle_t UI_Q3HeadIcon( const char *headName, qhandle_t *icon ) {
+	char	dirname[MAX_QPATH];
+	char	*skin;
+
+	if (*icon == -1) {
+		Q_strncpyz( dirname, headName, sizeof(dirname) );
+		skin = strchr( dirname, '/' );
+		if (skin) {
+			*skin++ = '\0';
+		} else {
+			skin = "default";
+		}
+		*icon = trap_R_RegisterShaderNoMip( va( "models/players/%s/icon_%s", dirname, skin ) );
+	}
+	return *icon;
+}
+
 static qhandle_t UI_FeederItemImage(float feederID, int index) {
   if (feederID == FEEDER_HEADS) {
 	int actual;
@@ -5425,11 +5733,11 @@ static qhandle_t UI_FeederItemImage(float feederID, int index) {
 	}
   } else if (feederID == FEEDER_Q3HEADS) {
     if (index >= 0 && index < uiInfo.q3HeadCount) {
-      return uiInfo.q3HeadIcons[index];
+      return UI_Q3HeadIcon(uiInfo.q3HeadNames[index], &uiInfo.q3HeadIcons[index]);
     }
   } else if (feederID == FEEDER_Q3HEADS_FULL) {
     if (index >= 0 && index < uiInfo.q3HeadCount2) {
-      return uiInfo.q3HeadIcons2[index];
+      return UI_Q3HeadIcon(uiInfo.q3HeadNames2[index], &uiInfo.q3HeadIcons2[index]);
     }
 	} else if (feederID == FEEDER_ALLMAPS || feederID == FEEDER_MAPS) {
 		int actual;
@@ -5983,109 +6291,54 @@ static void UI_RunCinematicFrame(int handle) {
 
 
 
+static modelCatalog_t	uiModelCatalog;
+
+
 /*
 =================
-PlayerModel_BuildList
+UI_BuildQ3Model_List
+
+Icons are registered when the feeder first shows them
 =================
 */
 static void UI_BuildQ3Model_List( void )
 {
-	int		numdirs;
-	int		numfiles;
-	char	dirlist[2048];
-	char	filelist[2048];
-	char	skinname[MAX_QPATH];
-	char	scratch[256];
-	char*	dirptr;
-	char*	fileptr;
-	int		i;
-	int		j, k, dirty;
-	int		dirlen;
-	int		filelen;
+	modelCatalog_t	*mc = &uiModelCatalog;
+	catalogDir_t	*dir;
+	const char		*dirname, *skinname;
+	char			scratch[256];
+	int				i, j;
+
+	BG_SyncModelCatalog( mc, qfalse, trap_FS_GetFileList, NULL );
 
 	uiInfo.q3HeadCount = 0;
 	uiInfo.q3HeadCount2 = 0;
 
-	// iterate directory of all player models
-	numdirs = trap_FS_GetFileList("models/players", "/", dirlist, 32768 ); // upped from 2048
-	dirptr  = dirlist;
-	for (i=0; i<numdirs && uiInfo.q3HeadCount < MAX_PLAYERMODELS; i++,dirptr+=dirlen+1)
+	for (i=0; i<mc->numOrder && uiInfo.q3HeadCount < MAX_PLAYERMODELS; i++)
 	{
-		dirlen = strlen(dirptr);
-		
-		if (dirlen && dirptr[dirlen-1]=='/') dirptr[dirlen-1]='\0';
-
-		if (!strcmp(dirptr,".") || !strcmp(dirptr,".."))
-			continue;
-			
-		// iterate all skin files in directory
-		numfiles = trap_FS_GetFileList( va("models/players/%s",dirptr), "tga", filelist, 2048 );
-		fileptr  = filelist;
-		for (j=0; j<numfiles && uiInfo.q3HeadCount < MAX_PLAYERMODELS;j++,fileptr+=filelen+1)
+		dir = &mc->dirs[mc->order[i]];
+		dirname = BG_CatalogDirName( mc, dir );
+		for (j=0; j<dir->numIcons && uiInfo.q3HeadCount < MAX_PLAYERMODELS; j++)
 		{
-			filelen = strlen(fileptr);
-
-			COM_StripExtension(fileptr, skinname, sizeof(skinname));
+			skinname = BG_CatalogIconName( mc, dir, j );
 
-			// look for icon_????
-			if (Q_stricmpn(skinname, "icon_", 5) == 0 && !(Q_stricmp(skinname,"icon_blue") == 0 || Q_stricmp(skinname,"icon_red") == 0))
-			//if (Q_stricmpn(skinname, "icon_", 5) == 0)	// leilei - show red blue anyway
+			if (Q_stricmp(skinname,"icon_blue") == 0 || Q_stricmp(skinname,"icon_red") == 0)
+				continue;
 
-			{
-				if (Q_stricmp(skinname, "icon_default") == 0) {
-					Com_sprintf( scratch, sizeof(scratch), "%s", dirptr);
-				} else {
-					Com_sprintf( scratch, sizeof(scratch), "%s/%s",dirptr, skinname + 5);
-				}
-				dirty = 0;
-				for(k=0;k<uiInfo.q3HeadCount;k++) {
-					if (!Q_stricmp(scratch, uiInfo.q3HeadNames[uiInfo.q3HeadCount])) {
-						dirty = 1;
-						break;
-					}
-				}
-				if (!dirty) {
-					Com_sprintf( uiInfo.q3HeadNames[uiInfo.q3HeadCount], sizeof(uiInfo.q3HeadNames[uiInfo.q3HeadCount]), "%s", scratch);
-                                    uiInfo.q3HeadIcons[uiInfo.q3HeadCount++] = trap_R_RegisterShaderNoMip(va("models/players/%s/%s",dirptr,skinname));
-				}
+			if (Q_stricmp(skinname, "icon_default") == 0) {
+				Com_sprintf( scratch, sizeof(scratch), "%s", dirname);
+			} else {
+				Com_sprintf( scratch, sizeof(scratch), "%s/%s",dirname, skinname + 5);
 			}
 
-		}
-
-	// Text Only list
-
-		for (j=0; j<numfiles && uiInfo.q3HeadCount2 < MAX_PLAYERMODELS;j++,fileptr+=filelen+1)
-		{
-			filelen = strlen(fileptr);
-
-			COM_StripExtension(fileptr, skinname, sizeof(skinname));
-
-			// look for icon_????
-			if (Q_stricmpn(skinname, "icon_", 5) == 0 && !(Q_stricmp(skinname,"icon_blue") == 0 || Q_stricmp(skinname,"icon_red") == 0))
-			//if (Q_stricmpn(skinname, "icon_", 5) == 0)	// leilei - show red blue anyway
-
-			{
-				if (Q_stricmp(skinname, "icon_default") == 0) {
-					Com_sprintf( scratch, sizeof(scratch), "%s", dirptr);
-				} else {
-					Com_sprintf( scratch, sizeof(scratch), "%s/%s",dirptr, skinname + 5);
-				}
-				dirty = 0;
-				for(k=0;k<uiInfo.q3HeadCount2;k++) {
-					if (!Q_stricmp(scratch, uiInfo.q3HeadNames2[uiInfo.q3HeadCount2])) {
-						dirty = 1;
-						break;
-					}
-				}
-				if (!dirty) {
-					Com_sprintf( uiInfo.q3HeadNames2[uiInfo.q3HeadCount2], sizeof(uiInfo.q3HeadNames2[uiInfo.q3HeadCount2]), "%s", scratch);
-                                    uiInfo.q3HeadIcons[uiInfo.q3HeadCount2++] = trap_R_RegisterShaderNoMip(va("models/players/%s/%s",dirptr,skinname));
-				}
-			}
+			Q_strncpyz( uiInfo.q3HeadNames[uiInfo.q3HeadCount], scratch, sizeof(uiInfo.q3HeadNames[0]) );
+			uiInfo.q3HeadIcons[uiInfo.q3HeadCount++] = -1;
 
+			// Text Only list
+			Q_strncpyz( uiInfo.q3HeadNames2[uiInfo.q3HeadCount2], scratch, sizeof(uiInfo.q3HeadNames2[0]) );
+			uiInfo.q3HeadIcons2[uiInfo.q3HeadCount2++] = -1;
 		}
-	}	
-
+	}
 }
 
 int realVidWidth;
@@ -6188,6 +6441,7 @@ void _UI_Init( qboolean inGameLoad ) {
 	uiInfo.uiDC.ownerDrawItem = &UI_OwnerDraw;
 	uiInfo.uiDC.getValue = &UI_GetValue;
 	uiInfo.uiDC.ownerDrawVisible = &UI_OwnerDrawVisible;
+	uiInfo.uiDC.ownerDrawDeps = &UI_OwnerDrawDeps;
 	uiInfo.uiDC.runScript = &UI_RunMenuScript;
 	uiInfo.uiDC.getTeamColor = &UI_GetTeamColor;
 	uiInfo.uiDC.setCVar = trap_Cvar_Set;
@@ -6953,6 +7207,9 @@ static cvarTable_t		cvarTable[] = {
 	{ &ui_server16, "server16", "", CVAR_ARCHIVE },
 	{ &ui_cdkeychecked, "ui_cdkeychecked", "0", CVAR_ROM },
 	{ &ui_new, "ui_new", "0", CVAR_TEMP },
+	{ &ui_menuCache, "ui_menuCache", "1", CVAR_ARCHIVE },
+	{ &ui_stringPoolSize, "ui_stringPoolSize", "0", CVAR_ARCHIVE },
+	{ &ui_paintCache, "ui_paintCache", "1", CVAR_ARCHIVE },
 	{ &ui_debug, "ui_debug", "0", CVAR_TEMP },
 	{ &ui_leidebug, "ui_leidebug", "0", CVAR_TEMP },
 	{ &ui_initialized, "ui_initialized", "0", CVAR_TEMP },
@@ -7187,6 +7444,8 @@ static void UI_StartServerRefresh(qboolean full)
 	trap_LAN_MarkServerVisible(ui_netSource.integer, -1, qtrue);
 	// reset all the pings
 	trap_LAN_ResetPings(ui_netSource.integer);
+	// the server numbers will refer to the new list
+	UI_ClearServerIndex();
 	//
 	if( ui_netSource.integer == AS_LOCAL ) {
 		trap_Cmd_ExecuteText( EXEC_NOW, "localservers\n" );
@@ -71,6 +71,10 @@ static qboolean debugMode = qfalse;
 static int lastListBoxClickTime = 0;
 
 void Item_RunScript(itemDef_t *item, const char *s);
+static void Script_Compile(const char *script);
+static void Script_InitPrograms(void);
+static void Cvar_InitWatches(void);
+static void Paint_Init(void);
 void Item_SetupKeywordHash(void);
 void Menu_SetupKeywordHash(void);
 int BindingIDFromName(const char *name);
@@ -134,44 +138,53 @@ qboolean UI_OutOfMemory( void ) {
 
 
 
-#define HASH_TABLE_SIZE 2048
 /*
 ================
-return a hash value for the string
+String_Hash
+
+FNV-1a with a final mix, so the low bits used for the table index
+depend on every character.  Also returns the length.
 ================
 */
-static unsigned hashForString(const char *str) {
-	int		i;
+static unsigned String_Hash(const char *str, int *len) {
+	const char	*s;
 	unsigned	hash;
-	char	letter;
 
-	hash = 0;
-	i = 0;
-	while (str[i] != '\0') {
-		letter = tolower(str[i]);
-		hash+=(unsigned)(letter)*(i+119);
-		i++;
+	hash = 2166136261u;
+	for (s = str; *s; s++) {
+		hash = (hash ^ (unsigned char)*s) * 16777619u;
 	}
-	hash &= (HASH_TABLE_SIZE-1);
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash >> 13;
+
+	*len = s - str;
 	return hash;
 }
 
-typedef struct stringDef_s {
-	struct stringDef_s *next;
-	const char *str;
+// open addressing with linear probing, kept at most 7/8 full
+typedef struct {
+	const char	*str;
+	int			len;
+	unsigned	hash;
 } stringDef_t;
 
 static int strPoolIndex = 0;
-static char strPool[STRING_POOL_SIZE];
+static int strPoolSize = STRING_POOL_SIZE;		// from STRING_POOL_CVAR
+static char strPool[STRING_POOL_MAX];
 
 static int strHandleCount = 0;
-static stringDef_t *strHandle[HASH_TABLE_SIZE];
+static stringDef_t strHandle[STRING_HASH_SIZE];
+static int strUnhashed = 0;		// stored without interning, the table was full
+static int strLookups = 0;
+static int strProbes = 0;
 
 
 const char *String_Alloc(const char *p) {
-	int len;
+	int len, i;
 	unsigned hash;
-	stringDef_t *str, *last;
+	stringDef_t *str;
+	char *s;
 	static const char *staticNULL = "";
 
 	if (p == NULL) {
@@ -182,40 +195,78 @@ const char *String_Alloc(const char *p) {
 		return staticNULL;
 	}
 
-	hash = hashForString(p);
+	hash = String_Hash(p, &len);
 
-	str = strHandle[hash];
-	while (str) {
-		if (strcmp(p, str->str) == 0) {
+	strLookups++;
+	for (i = hash & (STRING_HASH_SIZE-1); strHandle[i].str; i = (i + 1) & (STRING_HASH_SIZE-1)) {
+		str = &strHandle[i];
+		strProbes++;
+		if (str->hash == hash && str->len == len && strcmp(p, str->str) == 0) {
 			return str->str;
 		}
-		str = str->next;
 	}
 
-	len = strlen(p);
-	if (len + strPoolIndex + 1 < STRING_POOL_SIZE) {
-		int ph = strPoolIndex;
-		strcpy(&strPool[strPoolIndex], p);
-		strPoolIndex += len + 1;
+	if (len + strPoolIndex + 1 >= strPoolSize) {
+		return NULL;
+	}
+
+	s = &strPool[strPoolIndex];
+	memcpy(s, p, len + 1);
+	strPoolIndex += len + 1;
+
+	if (strHandleCount < STRING_HASH_SIZE - STRING_HASH_SIZE / 8) {
+		str = &strHandle[i];
+		str->str = s;
+		str->len = len;
+		str->hash = hash;
+		strHandleCount++;
+	} else {
+		strUnhashed++;
+	}
+	return s;
+}
+
+/*
+=================
+String_Unhash
 
-		str = strHandle[hash];
-		last = str;
-		while (str && str->next) {
-			last = str;
-			str = str->next;
+Empties slot i and moves later entries of its probe run up, so
+lookups never stop at the hole
+=================
+*/
+static void String_Unhash(int i) {
+	int j, home;
+
+	strHandle[i].str = NULL;
+	strHandleCount--;
+	for (j = (i + 1) & (STRING_HASH_SIZE-1); strHandle[j].str; j = (j + 1) & (STRING_HASH_SIZE-1)) {
+		home = strHandle[j].hash & (STRING_HASH_SIZE-1);
+		// entries whose home lies between the hole and them stay
+		if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) {
+			continue;
 		}
+		strHandle[i] = strHandle[j];
+		strHandle[j].str = NULL;
+		i = j;
+	}
+}
 
-		str  = UI_Alloc(sizeof(stringDef_t));
-		str->next = NULL;
-		str->str = &strPool[ph];
-		if (last) {
-			last->next = str;
-		} else {
-			strHandle[hash] = str;
+/*
+=================
+String_Release
+
+Gives back every string allocated since strPoolIndex was mark
+=================
+*/
+static void String_Release(int mark) {
+	int i;
+
+	for (i = 0; i < STRING_HASH_SIZE; i++) {
+		while (strHandle[i].str && strHandle[i].str >= &strPool[mark]) {
+			String_Unhash(i);
 		}
-		return &strPool[ph];
 	}
-	return NULL;
+	strPoolIndex = mark;
 }
 
 void String_Report(void) {
@@ -223,30 +274,82 @@ void String_Report(void) {
 	Com_Printf("Memory/String Pool Info\n");
 	Com_Printf("----------------\n");
 	f = strPoolIndex;
-	f /= STRING_POOL_SIZE;
+	f /= strPoolSize;
 	f *= 100;
-	Com_Printf("String Pool is %.1f%% full, %i bytes out of %i used.\n", f, strPoolIndex, STRING_POOL_SIZE);
+	Com_Printf("String Pool is %.1f%% full, %i bytes out of %i used.\n", f, strPoolIndex, strPoolSize);
 	f = allocPoint;
 	f /= MEM_POOL_SIZE;
 	f *= 100;
 	Com_Printf("Memory Pool is %.1f%% full, %i bytes out of %i used.\n", f, allocPoint, MEM_POOL_SIZE);
 }
 
+/*
+=================
+String_Stats
+
+How full the interner is, for sizing STRING_POOL_CVAR
+=================
+*/
+void String_Stats(void) {
+	int i, probe, maxProbe, totalProbe;
+
+	maxProbe = 0;
+	totalProbe = 0;
+	for (i = 0; i < STRING_HASH_SIZE; i++) {
+		if (!strHandle[i].str) {
+			continue;
+		}
+		probe = (i - strHandle[i].hash) & (STRING_HASH_SIZE-1);
+		totalProbe += probe;
+		if (probe > maxProbe) {
+			maxProbe = probe;
+		}
+	}
+
+	Com_Printf("%i strings in %i slots, load %.2f\n", strHandleCount, STRING_HASH_SIZE, (float)strHandleCount / STRING_HASH_SIZE);
+	if (strUnhashed) {
+		Com_Printf("%i strings not interned, the table was full\n", strUnhashed);
+	}
+	Com_Printf("probe distance: avg %.2f, max %i\n", strHandleCount ? (float)totalProbe / strHandleCount : 0.0f, maxProbe);
+	Com_Printf("%i lookups, %.2f compares per lookup\n", strLookups, strLookups ? (float)strProbes / strLookups : 0.0f);
+	Com_Printf("pool: %i of %i bytes used (%.1f%%), max %i kb through " STRING_POOL_CVAR "\n",
+		strPoolIndex, strPoolSize, 100.0f * strPoolIndex / strPoolSize, STRING_POOL_MAX / 1024);
+}
+
 /*
 =================
 String_Init
 =================
 */
 void String_Init(void) {
-	int i;
-	for (i = 0; i < HASH_TABLE_SIZE; i++) {
-		strHandle[i] = NULL;
-	}
+	char buf[16];
+	int size;
+
+	memset(strHandle, 0, sizeof(strHandle));
 	strHandleCount = 0;
+	strUnhashed = 0;
+	strLookups = 0;
+	strProbes = 0;
 	strPoolIndex = 0;
+
+	// in kb, can only grow the default
+	strPoolSize = STRING_POOL_SIZE;
+	// cgame runs this before Init_Display, so don't go through DC
+	trap_Cvar_VariableStringBuffer(STRING_POOL_CVAR, buf, sizeof(buf));
+	size = atoi(buf) * 1024;
+	if (size > STRING_POOL_MAX) {
+		size = STRING_POOL_MAX;
+	}
+	if (size > strPoolSize) {
+		strPoolSize = size;
+	}
+
 	menuCount = 0;
 	openMenuCount = 0;
 	UI_InitMemory();
+	Script_InitPrograms();
+	Cvar_InitWatches();
+	Paint_Init();
 	Item_SetupKeywordHash();
 	Menu_SetupKeywordHash();
 	if (DC && DC->getBindingBuf) {
@@ -545,6 +648,7 @@ qboolean PC_Script_Parse(int handle, const char **out) {
 
 		if (Q_stricmp(token.string, "}") == 0) {
 			*out = String_Alloc(script);
+			Script_Compile(*out);
 			return qtrue;
 		}
 
@@ -1539,14 +1643,186 @@ commandDef_t commandList[] =
 int scriptCommandCount = sizeof(commandList) / sizeof(commandDef_t);
 
 
-void Item_RunScript(itemDef_t *item, const char *s) {
-  char script[MAX_SCRIPTSIZE], *p;
+/*
+=============================================================================
+
+COMPILED SCRIPTS
+
+Scripts read by PC_Script_Parse are split into statements once, with the
+handler of each statement looked up in commandList, so running them
+doesn't need to copy and tokenize the script or search the command list.
+Programs are found by the address of the interned script string.
+
+A handler still parses its own arguments from the script text.  If it
+doesn't stop exactly at the end of its statement, the rest of the script
+is interpreted the old way, so such scripts still work as before.
+
+=============================================================================
+*/
+
+#define SCRIPT_HASH_SIZE	512
+#define MAX_SCRIPT_OPS		128
+
+typedef struct {
+	void		(*handler)(itemDef_t *item, char **args);	// NULL passes to DC->runScript
+	const char	*args;		// first argument in the script text
+	const char	*end;		// where the arguments of the statement end
+} scriptOp_t;
+
+typedef struct scriptProgram_s {
+	const char	*script;
+	int			numOps;
+	scriptOp_t	*ops;
+	struct scriptProgram_s *next;
+} scriptProgram_t;
+
+static scriptProgram_t *scriptHash[SCRIPT_HASH_SIZE];
+static int scriptGeneration;
+
+/*
+=================
+Script_InitPrograms
+
+The programs live in the UI memory pool, so they go with it
+=================
+*/
+static void Script_InitPrograms(void) {
+	memset(scriptHash, 0, sizeof(scriptHash));
+	scriptGeneration++;
+}
+
+/*
+=================
+Script_HashForScript
+=================
+*/
+static int Script_HashForScript(const char *script) {
+	return ((unsigned)(intptr_t)script >> 2) & (SCRIPT_HASH_SIZE - 1);
+}
+
+/*
+=================
+Script_FindProgram
+=================
+*/
+static scriptProgram_t *Script_FindProgram(const char *script) {
+	scriptProgram_t *prog;
+
+	for (prog = scriptHash[Script_HashForScript(script)]; prog; prog = prog->next) {
+		if (prog->script == script) {
+			return prog;
+		}
+	}
+	return NULL;
+}
+
+/*
+=================
+Script_ReleasePrograms
+
+Forgets the programs allocated at or after mark in the UI memory pool.
+Each chain holds the newest program first.
+=================
+*/
+static void Script_ReleasePrograms(const char *mark) {
+	int i;
+
+	for (i = 0; i < SCRIPT_HASH_SIZE; i++) {
+		while (scriptHash[i] && (const char *)scriptHash[i] >= mark) {
+			scriptHash[i] = scriptHash[i]->next;
+		}
+	}
+}
+
+/*
+=================
+Script_Compile
+
+script must stay valid as long as the UI memory pool, so it has
+to come from String_Alloc
+=================
+*/
+static void Script_Compile(const char *script) {
+	scriptOp_t ops[MAX_SCRIPT_OPS];
+	scriptProgram_t *prog;
+	char *p, *prev, *token;
+	int i, numOps, hash;
+	qboolean done;
+
+	if (!script || !script[0] || Script_FindProgram(script)) {
+		return;
+	}
+
+	numOps = 0;
+	done = qfalse;
+	p = (char *)script;
+	while (!done) {
+		token = COM_ParseExt(&p, qfalse);
+		if (!token[0]) {
+			break;
+		}
+		if (token[0] == ';' && token[1] == '\0') {
+			continue;
+		}
+		if (numOps == MAX_SCRIPT_OPS) {
+			return;
+		}
+
+		ops[numOps].handler = NULL;
+		for (i = 0; i < scriptCommandCount; i++) {
+			if (Q_stricmp(token, commandList[i].name) == 0) {
+				ops[numOps].handler = commandList[i].handler;
+				break;
+			}
+		}
+		ops[numOps].args = p;
+
+		// the arguments run up to the next ; or the end of the script
+		while (1) {
+			prev = p;
+			token = COM_ParseExt(&p, qfalse);
+			if (!token[0]) {
+				done = qtrue;
+				break;
+			}
+			if (token[0] == ';' && token[1] == '\0') {
+				break;
+			}
+		}
+		ops[numOps].end = prev;
+		numOps++;
+	}
+
+	prog = UI_Alloc(sizeof(scriptProgram_t));
+	if (!prog) {
+		return;
+	}
+	prog->ops = NULL;
+	if (numOps) {
+		prog->ops = UI_Alloc(numOps * sizeof(scriptOp_t));
+		if (!prog->ops) {
+			return;
+		}
+		memcpy(prog->ops, ops, numOps * sizeof(scriptOp_t));
+	}
+	prog->script = script;
+	prog->numOps = numOps;
+
+	hash = Script_HashForScript(script);
+	prog->next = scriptHash[hash];
+	scriptHash[hash] = prog;
+}
+
+/*
+=================
+Item_RunScriptText
+
+Interprets p, which is changed while parsing
+=================
+*/
+static void Item_RunScriptText(itemDef_t *item, char *p) {
   int i;
   qboolean bRan;
-  memset(script, 0, sizeof(script));
-  if (item && s && s[0]) {
-    Q_strcat(script, MAX_SCRIPTSIZE, s);
-    p = script;
     while (1) {
       const char *command;
       // expect command then arguments, ; ends command, NULL ends script
@@ -1571,44 +1847,174 @@ void Item_RunScript(itemDef_t *item, const char *s) {
         DC->runScript(&p);
       }
     }
+}
+
+void Item_RunScript(itemDef_t *item, const char *s) {
+  char script[MAX_SCRIPTSIZE], *p;
+  scriptProgram_t *prog;
+  scriptOp_t *op;
+  int i, generation;
+  if (item && s && s[0]) {
+    prog = Script_FindProgram(s);
+    if (prog) {
+      generation = scriptGeneration;
+      for (i = 0, op = prog->ops; i < prog->numOps; i++, op++) {
+        p = (char *)op->args;
+        if (op->handler) {
+          op->handler(item, &p);
+        } else {
+          DC->runScript(&p);
+        }
+        // the menus were reloaded under us
+        if (scriptGeneration != generation) {
+          return;
+        }
+        // the command read more or less than its own arguments
+        if (p != op->end) {
+          Item_RunScriptText(item, p);
+          return;
+        }
+      }
+      return;
+    }
+
+    Q_strncpyz(script, s, sizeof(script));
+    Item_RunScriptText(item, script);
   }
 }
 
 
-qboolean Item_EnableShowViaCvar(itemDef_t *item, int flag) {
+/*
+=============================================================================
+
+WATCHED CVARS
+
+The cvars tested by cvarTest items are registered here and updated once
+a frame by Display_UpdateCvarWatches, so an item only has to check its
+enableCvar list again when the modificationCount of its cvar changes.
+
+=============================================================================
+*/
+
+#define MAX_CVAR_WATCHES	128
+
+typedef struct {
+	const char	*name;
+	vmCvar_t	cvar;
+} cvarWatch_t;
+
+static cvarWatch_t cvarWatches[MAX_CVAR_WATCHES];
+static int cvarWatchCount;
+
+/*
+=================
+Cvar_InitWatches
+
+The names come from the string pool, so they go with it
+=================
+*/
+static void Cvar_InitWatches(void) {
+	cvarWatchCount = 0;
+}
+
+/*
+=================
+Cvar_Watch
+
+Returns 1 + the watch slot of name, or -1 if they are all used
+=================
+*/
+static int Cvar_Watch(const char *name) {
+	cvarWatch_t *watch;
+	int i;
+
+	for (i = 0; i < cvarWatchCount; i++) {
+		if (Q_stricmp(cvarWatches[i].name, name) == 0) {
+			return i + 1;
+		}
+	}
+
+	if (cvarWatchCount == MAX_CVAR_WATCHES) {
+		return -1;
+	}
+
+	watch = &cvarWatches[cvarWatchCount++];
+	watch->name = name;
+	trap_Cvar_Register(&watch->cvar, name, "", 0);
+	return cvarWatchCount;
+}
+
+/*
+=================
+Display_UpdateCvarWatches
+
+Called once a frame
+=================
+*/
+void Display_UpdateCvarWatches(void) {
+	int i;
+
+	for (i = 0; i < cvarWatchCount; i++) {
+		trap_Cvar_Update(&cvarWatches[i].cvar);
+	}
+}
+
+/*
+=================
+Item_CvarTestMatch
+
+Returns qtrue if value is one of the values in the enableCvar list
+=================
+*/
+static qboolean Item_CvarTestMatch(itemDef_t *item, const char *value) {
   char script[1024], *p;
   memset(script, 0, sizeof(script));
-  if (item && item->enableCvar && *item->enableCvar && item->cvarTest && *item->cvarTest) {
-		char buff[1024];
-	  DC->getCVarString(item->cvarTest, buff, sizeof(buff));
-
     Q_strcat(script, 1024, item->enableCvar);
     p = script;
     while (1) {
       const char *val;
       // expect value then ; or NULL, NULL ends list
       if (!String_Parse(&p, &val)) {
-				return (item->cvarFlags & flag) ? qfalse : qtrue;
+				return qfalse;
       }
 
       if (val[0] == ';' && val[1] == '\0') {
         continue;
       }
 
-			// enable it if any of the values are true
-			if (item->cvarFlags & flag) {
-        if (Q_stricmp(buff, val) == 0) {
-					return qtrue;
-				}
-			} else {
-				// disable it if any of the values are true
-        if (Q_stricmp(buff, val) == 0) {
-					return qfalse;
-				}
+      if (Q_stricmp(value, val) == 0) {
+				return qtrue;
 			}
-
     }
-		return (item->cvarFlags & flag) ? qfalse : qtrue;
+	return qfalse;
+}
+
+qboolean Item_EnableShowViaCvar(itemDef_t *item, int flag) {
+	qboolean match;
+  if (item && item->enableCvar && *item->enableCvar && item->cvarTest && *item->cvarTest) {
+		if (!item->cvarWatch) {
+			item->cvarWatch = Cvar_Watch(item->cvarTest);
+			item->cvarTestCount = -1;
+		}
+
+		if (item->cvarWatch > 0) {
+			cvarWatch_t *watch = &cvarWatches[item->cvarWatch - 1];
+			if (item->cvarTestCount != watch->cvar.modificationCount) {
+				item->cvarTestMatch = Item_CvarTestMatch(item, watch->cvar.string);
+				item->cvarTestCount = watch->cvar.modificationCount;
+			}
+			match = item->cvarTestMatch;
+		} else {
+			char buff[1024];
+			DC->getCVarString(item->cvarTest, buff, sizeof(buff));
+			match = Item_CvarTestMatch(item, buff);
+		}
+
+		// enable it if any of the values are true, disable it otherwise
+		if (item->cvarFlags & flag) {
+			return match;
+		}
+		return !match;
   }
 	return qtrue;
 }
@@ -4750,42 +5156,410 @@ void Item_OwnerDraw_Paint(itemDef_t *item) {
 }
 
 
-void Item_Paint(itemDef_t *item) {
-  vec4_t red;
-  menuDef_t *parent = (menuDef_t*)item->parent;
-  red[0] = red[3] = 1;
-  red[1] = red[2] = 0;
+/*
+=============================================================================
 
-  if (item == NULL) {
-    return;
-  }
+PAINT CACHE
 
-  if (item->window.flags & WINDOW_ORBITING) {
-    if (DC->realTime > item->window.nextTime) {
-      float rx, ry, a, c, s, w, h;
-      
-      item->window.nextTime = DC->realTime + item->window.offsetTime;
-      // translate
-      w = item->window.rectClient.w / 2;
-      h = item->window.rectClient.h / 2;
-      rx = item->window.rectClient.x + w - item->window.rectEffects.x;
-      ry = item->window.rectClient.y + h - item->window.rectEffects.y;
-      a = 3 * M_PI / 180;
-  	  c = cos(a);
-      s = sin(a);
-      item->window.rectClient.x = (rx * c - ry * s) + item->window.rectEffects.x - w;
-      item->window.rectClient.y = (rx * s + ry * c) + item->window.rectEffects.y - h;
-      Item_UpdatePosition(item);
+Most items draw exactly the same thing every frame.  While an item is
+painted its trap_R_SetColor and trap_R_DrawStretchPic calls are recorded
+through the wrappers in ui_local.h and cg_local.h, and as long as its
+inputs hash to the same key the recorded commands are replayed instead
+of running the paint code again.  The inputs are the window state, the
+text, the cvars the item shows and, for owner draws, whatever
+DC->ownerDrawDeps declares.  Anything animated, fed by a feeder or drawn
+with a model or cinematic is painted every frame.
 
-    }
-  }
+When the command pool fills up it is thrown away as a whole and the
+items record again the next time they are painted.
 
+=============================================================================
+*/
 
-  if (item->window.flags & WINDOW_INTRANSITION) {
-    if (DC->realTime > item->window.nextTime) {
-      int done = 0;
-      item->window.nextTime = DC->realTime + item->window.offsetTime;
-			// transition the x,y
+#define PAINT_COLOR		-1		// shader of a trap_R_SetColor command
+#define PAINT_NOCOLOR	-2		// trap_R_SetColor( NULL )
+
+typedef struct {
+	qhandle_t	shader;
+	float		v[8];			// x y w h s1 t1 s2 t2 or the color
+} paintCmd_t;
+
+qboolean paintRecording;
+
+static paintCmd_t paintCmds[PAINT_CACHE_CMDS];
+static int paintCmdCount;
+static int paintGeneration;
+static int paintRecordStart;
+static qboolean paintOverflow;
+
+// the last trap_R_SetColor, so a recording can start with it
+static vec4_t paintColor;
+static qboolean paintColorSet;
+
+static int paintCacheWatch;		// 1 + watch slot of PAINT_CACHE_CVAR
+static int paintHits, paintRecords, paintFlushes;
+
+/*
+=================
+Paint_Init
+
+The items go with the string pool, so their recordings do too
+=================
+*/
+static void Paint_Init(void) {
+	paintCmdCount = 0;
+	paintGeneration++;
+	paintRecording = qfalse;
+	paintCacheWatch = 0;
+	paintHits = paintRecords = paintFlushes = 0;
+}
+
+/*
+=================
+Paint_AllocCmd
+=================
+*/
+static paintCmd_t *Paint_AllocCmd(void) {
+	if (paintOverflow) {
+		return NULL;
+	}
+	if (paintCmdCount == PAINT_CACHE_CMDS) {
+		paintOverflow = qtrue;
+		return NULL;
+	}
+	return &paintCmds[paintCmdCount++];
+}
+
+/*
+=================
+Paint_RecordColor
+=================
+*/
+static void Paint_RecordColor(void) {
+	paintCmd_t *cmd;
+
+	cmd = Paint_AllocCmd();
+	if (!cmd) {
+		return;
+	}
+	if (paintColorSet) {
+		cmd->shader = PAINT_COLOR;
+		Vector4Copy(paintColor, cmd->v);
+	} else {
+		cmd->shader = PAINT_NOCOLOR;
+	}
+}
+
+/*
+=================
+Paint_TrackColor
+
+Called for every trap_R_SetColor
+=================
+*/
+void Paint_TrackColor(const float *rgba) {
+	if (rgba) {
+		Vector4Copy(rgba, paintColor);
+		paintColorSet = qtrue;
+	} else {
+		paintColorSet = qfalse;
+	}
+
+	if (paintRecording) {
+		Paint_RecordColor();
+	}
+}
+
+/*
+=================
+Paint_RecordStretchPic
+
+Called for trap_R_DrawStretchPic while recording
+=================
+*/
+void Paint_RecordStretchPic(float x, float y, float w, float h, float s1, float t1, float s2, float t2, qhandle_t hShader) {
+	paintCmd_t *cmd;
+
+	cmd = Paint_AllocCmd();
+	if (!cmd) {
+		return;
+	}
+	cmd->shader = hShader;
+	cmd->v[0] = x;
+	cmd->v[1] = y;
+	cmd->v[2] = w;
+	cmd->v[3] = h;
+	cmd->v[4] = s1;
+	cmd->v[5] = t1;
+	cmd->v[6] = s2;
+	cmd->v[7] = t2;
+}
+
+/*
+=================
+Paint_BeginRecord
+=================
+*/
+static void Paint_BeginRecord(void) {
+	paintRecording = qtrue;
+	paintOverflow = qfalse;
+	paintRecordStart = paintCmdCount;
+
+	// what the item draws before its first setColor depends on
+	// whatever was drawn before it
+	Paint_RecordColor();
+}
+
+/*
+=================
+Paint_EndRecord
+=================
+*/
+static void Paint_EndRecord(paintCache_t *pc, unsigned key) {
+	paintRecording = qfalse;
+
+	if (paintOverflow) {
+		if (paintRecordStart == 0) {
+			// doesn't even fit an empty pool
+			pc->state = -1;
+		}
+		paintCmdCount = 0;
+		paintGeneration++;
+		paintFlushes++;
+		return;
+	}
+
+	pc->key = key;
+	pc->first = paintRecordStart;
+	pc->count = paintCmdCount - paintRecordStart;
+	pc->generation = paintGeneration;
+	paintRecords++;
+}
+
+/*
+=================
+Paint_Replay
+
+Returns qfalse if there is nothing recorded for key
+=================
+*/
+static qboolean Paint_Replay(paintCache_t *pc, unsigned key) {
+	paintCmd_t *cmd;
+	int i;
+
+	if (pc->generation != paintGeneration || pc->key != key) {
+		return qfalse;
+	}
+
+	for (i = 0, cmd = &paintCmds[pc->first]; i < pc->count; i++, cmd++) {
+		if (cmd->shader == PAINT_COLOR) {
+			DC->setColor(cmd->v);
+		} else if (cmd->shader == PAINT_NOCOLOR) {
+			DC->setColor(NULL);
+		} else {
+			DC->drawStretchPic(cmd->v[0], cmd->v[1], cmd->v[2], cmd->v[3], cmd->v[4], cmd->v[5], cmd->v[6], cmd->v[7], cmd->shader);
+		}
+	}
+	paintHits++;
+	return qtrue;
+}
+
+/*
+=================
+Paint_Hash
+=================
+*/
+static unsigned Paint_Hash(unsigned hash, const void *data, int size) {
+	const unsigned char *p = data;
+
+	while (size-- > 0) {
+		hash = (hash ^ *p++) * 16777619u;
+	}
+	return hash;
+}
+
+/*
+=================
+Paint_Stats
+=================
+*/
+void Paint_Stats(void) {
+	Com_Printf("%i of %i paint commands used, generation %i\n", paintCmdCount, PAINT_CACHE_CMDS, paintGeneration);
+	Com_Printf("%i replays, %i recordings, %i flushes\n", paintHits, paintRecords, paintFlushes);
+}
+
+/*
+=================
+Item_PaintInit
+
+Decides once if an item can be cached at all and looks up the
+cvars it reads
+=================
+*/
+static qboolean Item_PaintInit(itemDef_t *item, const char *ownerDrawCvar) {
+	paintCache_t *pc = &item->paint;
+	int n;
+
+	switch (item->type) {
+		case ITEM_TYPE_TEXT:
+		case ITEM_TYPE_BUTTON:
+		case ITEM_TYPE_RADIOBUTTON:
+		case ITEM_TYPE_YESNO:
+		case ITEM_TYPE_MULTI:
+		case ITEM_TYPE_SLIDER:
+		case ITEM_TYPE_OWNERDRAW:
+			break;
+		default:
+			// edit fields blink, list boxes come from feeders, models
+			// animate and the rest keep their state elsewhere
+			return qfalse;
+	}
+
+	if (item->window.style == WINDOW_STYLE_TEAMCOLOR || item->window.style == WINDOW_STYLE_CINEMATIC) {
+		return qfalse;
+	}
+
+	if (item->enableCvar && *item->enableCvar && item->cvarTest && *item->cvarTest) {
+		if (!item->cvarWatch) {
+			item->cvarWatch = Cvar_Watch(item->cvarTest);
+			item->cvarTestCount = -1;
+		}
+		if (item->cvarWatch < 0) {
+			return qfalse;
+		}
+	}
+
+	n = 0;
+	if (item->cvar && *item->cvar) {
+		pc->watches[n++] = Cvar_Watch(item->cvar);
+	}
+	if (ownerDrawCvar && *ownerDrawCvar) {
+		pc->watches[n++] = Cvar_Watch(ownerDrawCvar);
+	}
+	while (n-- > 0) {
+		if (pc->watches[n] < 0) {
+			return qfalse;
+		}
+	}
+	return qtrue;
+}
+
+/*
+=================
+Item_PaintKey
+
+Hashes everything the item's paint depends on, returns qfalse
+if it has to be painted every frame
+=================
+*/
+static qboolean Item_PaintKey(itemDef_t *item, unsigned *key) {
+	paintCache_t *pc = &item->paint;
+	const char *ownerDrawCvar = NULL;
+	int ownerDrawKey = 0;
+	unsigned hash;
+	float value;
+	int i;
+
+	if (!paintCacheWatch) {
+		paintCacheWatch = Cvar_Watch(PAINT_CACHE_CVAR);
+	}
+	if (paintCacheWatch < 0 || !cvarWatches[paintCacheWatch - 1].cvar.integer) {
+		return qfalse;
+	}
+
+	if (pc->state < 0 || paintRecording || debugMode) {
+		return qfalse;
+	}
+
+	// pulsing, blinking and moving
+	if (item->window.flags & (WINDOW_HASFOCUS | WINDOW_FADINGIN | WINDOW_FADINGOUT | WINDOW_INTRANSITION | WINDOW_ORBITING)) {
+		return qfalse;
+	}
+	if (item->textStyle == ITEM_TEXTSTYLE_BLINK) {
+		return qfalse;
+	}
+
+	if (item->type == ITEM_TYPE_OWNERDRAW) {
+		if (!DC->ownerDrawDeps || !DC->ownerDrawDeps(item->window.ownerDraw, &ownerDrawKey, &ownerDrawCvar)) {
+			return qfalse;
+		}
+	}
+
+	if (!pc->state) {
+		pc->state = Item_PaintInit(item, ownerDrawCvar) ? 1 : -1;
+		if (pc->state < 0) {
+			return qfalse;
+		}
+	}
+
+	hash = 2166136261u;
+	hash = Paint_Hash(hash, &item->window.flags, sizeof(item->window.flags));
+	hash = Paint_Hash(hash, &item->window.rect, sizeof(item->window.rect));
+	hash = Paint_Hash(hash, item->window.foreColor, sizeof(vec4_t));
+	hash = Paint_Hash(hash, item->window.backColor, sizeof(vec4_t));
+	hash = Paint_Hash(hash, item->window.borderColor, sizeof(vec4_t));
+	hash = Paint_Hash(hash, &item->window.background, sizeof(item->window.background));
+	if (item->text) {
+		hash = Paint_Hash(hash, item->text, strlen(item->text));
+	}
+
+	for (i = 0; i < MAX_PAINT_WATCHES && pc->watches[i] > 0; i++) {
+		hash = Paint_Hash(hash, &cvarWatches[pc->watches[i] - 1].cvar.modificationCount, sizeof(int));
+	}
+	if (item->cvarWatch > 0) {
+		hash = Paint_Hash(hash, &cvarWatches[item->cvarWatch - 1].cvar.modificationCount, sizeof(int));
+	}
+
+	if (item->type == ITEM_TYPE_OWNERDRAW) {
+		hash = Paint_Hash(hash, &ownerDrawKey, sizeof(ownerDrawKey));
+		if (item->numColors > 0 && DC->getValue) {
+			value = DC->getValue(item->window.ownerDraw);
+			hash = Paint_Hash(hash, &value, sizeof(value));
+		}
+	}
+
+	*key = hash;
+	return qtrue;
+}
+
+void Item_Paint(itemDef_t *item) {
+  vec4_t red;
+  menuDef_t *parent = (menuDef_t*)item->parent;
+  unsigned key;
+  qboolean cache;
+  red[0] = red[3] = 1;
+  red[1] = red[2] = 0;
+
+  if (item == NULL) {
+    return;
+  }
+
+  if (item->window.flags & WINDOW_ORBITING) {
+    if (DC->realTime > item->window.nextTime) {
+      float rx, ry, a, c, s, w, h;
+      
+      item->window.nextTime = DC->realTime + item->window.offsetTime;
+      // translate
+      w = item->window.rectClient.w / 2;
+      h = item->window.rectClient.h / 2;
+      rx = item->window.rectClient.x + w - item->window.rectEffects.x;
+      ry = item->window.rectClient.y + h - item->window.rectEffects.y;
+      a = 3 * M_PI / 180;
+  	  c = cos(a);
+      s = sin(a);
+      item->window.rectClient.x = (rx * c - ry * s) + item->window.rectEffects.x - w;
+      item->window.rectClient.y = (rx * s + ry * c) + item->window.rectEffects.y - h;
+      Item_UpdatePosition(item);
+
+    }
+  }
+
+
+  if (item->window.flags & WINDOW_INTRANSITION) {
+    if (DC->realTime > item->window.nextTime) {
+      int done = 0;
+      item->window.nextTime = DC->realTime + item->window.offsetTime;
+			// transition the x,y
 			if (item->window.rectClient.x == item->window.rectEffects.x) {
 				done++;
 			} else {
@@ -4891,6 +5665,14 @@ void Item_Paint(itemDef_t *item) {
     return;
   }
 
+  cache = Item_PaintKey(item, &key);
+  if (cache) {
+    if (Paint_Replay(&item->paint, key)) {
+      return;
+    }
+    Paint_BeginRecord();
+  }
+
   // paint the rect first.. 
   Window_Paint(&item->window, parent->fadeAmount , parent->fadeClamp, parent->fadeCycle);
 
@@ -4953,6 +5735,9 @@ void Item_Paint(itemDef_t *item) {
       break;
   }
 
+  if (cache) {
+    Paint_EndRecord(&item->paint, key);
+  }
 }
 
 void Menu_Init(menuDef_t *menu) {
@@ -5247,6 +6032,7 @@ void Item_ValidateTypeData(itemDef_t *item) {
 		}
 	} else if (item->type == ITEM_TYPE_MULTI) {
 		item->typeData = UI_Alloc(sizeof(multiDef_t));
+		memset(item->typeData, 0, sizeof(multiDef_t));
 	} else if (item->type == ITEM_TYPE_MODEL) {
 		item->typeData = UI_Alloc(sizeof(modelDef_t));
 // Changed RD
@@ -5341,6 +6127,7 @@ qboolean ItemParse_focusSound( itemDef_t *item, int handle ) {
 		return qfalse;
 	}
 	item->focusSound = DC->registerSound(temp, qfalse);
+	item->focusSoundName = temp;
 	return qtrue;
 }
 
@@ -5372,6 +6159,8 @@ qboolean ItemParse_asset_model( itemDef_t *item, int handle ) {
 		return qfalse;
 	}
 	item->asset = DC->registerModel(temp);
+	item->assetModel = temp;
+	item->assetShader = NULL;
 //	modelPtr->angle = rand() % 360;
 	modelPtr->angle = 0;	// leilei - don't do this because it makes menu changing inconsistent
 
@@ -5386,6 +6175,8 @@ qboolean ItemParse_asset_shader( itemDef_t *item, int handle ) {
 		return qfalse;
 	}
 	item->asset = DC->registerShaderNoMip(temp);
+	item->assetShader = temp;
+	item->assetModel = NULL;
 	return qtrue;
 }
 
@@ -5844,6 +6635,7 @@ qboolean ItemParse_background( itemDef_t *item, int handle ) {
 		return qfalse;
 	}
 	item->window.background = DC->registerShaderNoMip(temp);
+	item->window.backgroundName = temp;
 	return qtrue;
 }
 
@@ -6116,6 +6908,7 @@ qboolean ItemParse_cvarFloatBoxList( itemDef_t *item, int handle ) {
 	item->multiData = UI_Alloc(sizeof(multiDef_t));
 	if (!item->multiData)
 		return qfalse;
+	memset(item->multiData, 0, sizeof(multiDef_t));
 	multiPtr = (multiDef_t*)item->multiData;
 	multiPtr->count = 0;
 	multiPtr->strDef = qfalse;
@@ -6165,6 +6958,7 @@ qboolean ItemParse_cvarStrBoxList( itemDef_t *item, int handle ) {
 	item->multiData = UI_Alloc(sizeof(multiDef_t));
 	if (!item->multiData)
 		return qfalse;
+	memset(item->multiData, 0, sizeof(multiDef_t));
 	multiPtr = (multiDef_t*)item->multiData;
 	multiPtr->count = 0;
 	multiPtr->strDef = qtrue;
@@ -6648,6 +7442,7 @@ qboolean MenuParse_background( itemDef_t *item, int handle ) {
 		return qfalse;
 	}
 	menu->window.background = DC->registerShaderNoMip(buff);
+	menu->window.backgroundName = buff;
 	return qtrue;
 }
 
@@ -6858,6 +7653,651 @@ void Menu_New(int handle) {
 	}
 }
 
+#ifndef CGAME
+/*
+=============================================================================
+
+MENU CACHE
+
+After a menu file has been parsed, the menus it defined are written to
+menucache/<file>.bin together with the length and a hash of the file and
+of everything it includes.  The next time the file is loaded and none of
+them changed, the menus are read back from there instead of going
+through the precompiler.  Strings go back through String_Alloc, scripts
+are compiled again and shaders, models and sounds are registered again
+by name, so nothing in the file depends on the previous session.
+
+=============================================================================
+*/
+
+#define MENUCACHE_IDENT			(('C'<<24)+('M'<<16)+('I'<<8)+'U')
+#define MENUCACHE_VERSION		1
+#define MAX_MENUCACHE_SOURCES	16
+
+typedef struct {
+	int		ident;
+	int		version;
+	int		structSizes[8];		// a rebuilt module must not read old files
+	float	fadeAmount;			// Menu_Init copies these from the assets
+	float	fadeClamp;
+	int		fadeCycle;
+	int		numSources;
+	int		numMenus;
+} menuCacheHeader_t;
+
+typedef struct {
+	char		name[MAX_QPATH];
+	int			length;			// -1 if the file doesn't exist
+	unsigned	hash;
+} menuCacheSource_t;
+
+typedef struct {
+	fileHandle_t	f;
+	qboolean		writing;
+	int				remaining;		// bytes left in the file when reading
+	qboolean		error;
+} menuCache_t;
+
+static char menuCacheText[MAX_MENUFILE];
+
+/*
+=================
+MenuCache_SetHeader
+=================
+*/
+static void MenuCache_SetHeader(menuCacheHeader_t *header) {
+	memset(header, 0, sizeof(*header));
+	header->ident = MENUCACHE_IDENT;
+	header->version = MENUCACHE_VERSION;
+	header->structSizes[0] = sizeof(menuDef_t);
+	header->structSizes[1] = sizeof(itemDef_t);
+	header->structSizes[2] = sizeof(listBoxDef_t);
+	header->structSizes[3] = sizeof(editFieldDef_t);
+	header->structSizes[4] = sizeof(multiDef_t);
+	header->structSizes[5] = sizeof(modelDef_t);
+	header->structSizes[6] = sizeof(comboDef_t);
+	header->structSizes[7] = sizeof(void *);
+	header->fadeAmount = DC->Assets.fadeAmount;
+	header->fadeClamp = DC->Assets.fadeClamp;
+	header->fadeCycle = DC->Assets.fadeCycle;
+}
+
+/*
+=================
+MenuCache_HashSource
+
+Reads the source into menuCacheText, returns qfalse if it is too
+large to be checked
+=================
+*/
+static qboolean MenuCache_HashSource(menuCacheSource_t *src) {
+	fileHandle_t f;
+	unsigned hash;
+	int i, len;
+
+	src->length = -1;
+	src->hash = 0;
+	menuCacheText[0] = 0;
+
+	len = trap_FS_FOpenFile(src->name, &f, FS_READ);
+	if (!f) {
+		return qtrue;
+	}
+	if (len >= MAX_MENUFILE) {
+		trap_FS_FCloseFile(f);
+		return qfalse;
+	}
+	trap_FS_Read(menuCacheText, len, f);
+	trap_FS_FCloseFile(f);
+	menuCacheText[len] = 0;
+
+	hash = 2166136261u;
+	for (i = 0; i < len; i++) {
+		hash = (hash ^ (unsigned char)menuCacheText[i]) * 16777619u;
+	}
+	src->length = len;
+	src->hash = hash;
+	return qtrue;
+}
+
+/*
+=================
+MenuCache_AddIncludes
+
+Adds the files #included by the text in menuCacheText.  Comments and
+strings are skipped the way the precompiler skips them, and #include
+only counts as the first thing on a line.  Returns qfalse if there are
+more sources than a cache file can track.
+=================
+*/
+static qboolean MenuCache_AddIncludes(menuCacheSource_t *sources, int *numSources) {
+	char name[MAX_QPATH];
+	char *p, end;
+	int i, len;
+	qboolean lineStart;
+
+	p = menuCacheText;
+	lineStart = qtrue;
+	while (*p) {
+		if (p[0] == '/' && p[1] == '/') {
+			while (*p && *p != '\n') {
+				p++;
+			}
+			continue;
+		}
+		if (p[0] == '/' && p[1] == '*') {
+			p += 2;
+			while (*p && !(p[0] == '*' && p[1] == '/')) {
+				p++;
+			}
+			if (*p) {
+				p += 2;
+			}
+			continue;
+		}
+		if (*p == '\n') {
+			lineStart = qtrue;
+			p++;
+			continue;
+		}
+		if (*p == ' ' || *p == '\t' || *p == '\r') {
+			p++;
+			continue;
+		}
+		if (*p == '"') {
+			p++;
+			while (*p && *p != '"' && *p != '\n') {
+				p++;
+			}
+			if (*p == '"') {
+				p++;
+			}
+			lineStart = qfalse;
+			continue;
+		}
+		if (!lineStart || Q_strncmp(p, "#include", 8)) {
+			lineStart = qfalse;
+			p++;
+			continue;
+		}
+		lineStart = qfalse;
+
+		p += 8;
+		while (*p == ' ' || *p == '\t') {
+			p++;
+		}
+		if (*p == '"') {
+			end = '"';
+		} else if (*p == '<') {
+			end = '>';
+		} else {
+			continue;
+		}
+		p++;
+		for (len = 0; p[len] && p[len] != end && p[len] != '\n'; len++) {
+		}
+		if (p[len] != end || len == 0 || len >= sizeof(name)) {
+			continue;
+		}
+		Q_strncpyz(name, p, len + 1);
+		p += len + 1;
+
+		for (i = 0; i < *numSources; i++) {
+			if (!Q_stricmp(sources[i].name, name)) {
+				break;
+			}
+		}
+		if (i < *numSources) {
+			continue;
+		}
+		if (*numSources == MAX_MENUCACHE_SOURCES) {
+			Com_Printf(S_COLOR_YELLOW "WARNING: %s includes more than %i files, not cached\n",
+				sources[0].name, MAX_MENUCACHE_SOURCES - 1);
+			return qfalse;
+		}
+		Q_strncpyz(sources[*numSources].name, name, sizeof(sources[0].name));
+		(*numSources)++;
+	}
+	return qtrue;
+}
+
+/*
+=================
+MenuCache_Data
+=================
+*/
+static void MenuCache_Data(menuCache_t *mc, void *data, int size) {
+	if (mc->error) {
+		return;
+	}
+	if (mc->writing) {
+		trap_FS_Write(data, size, mc->f);
+		return;
+	}
+	if (size > mc->remaining) {
+		mc->error = qtrue;
+		return;
+	}
+	trap_FS_Read(data, size, mc->f);
+	mc->remaining -= size;
+}
+
+/*
+=================
+MenuCache_String
+=================
+*/
+static void MenuCache_String(menuCache_t *mc, const char **s) {
+	static char buf[MAX_SCRIPTSIZE];
+	int len;
+
+	if (mc->writing) {
+		len = *s ? strlen(*s) : -1;
+		MenuCache_Data(mc, &len, sizeof(len));
+		if (len > 0) {
+			MenuCache_Data(mc, (void *)*s, len);
+		}
+		return;
+	}
+
+	*s = NULL;
+	MenuCache_Data(mc, &len, sizeof(len));
+	if (mc->error || len < 0) {
+		return;
+	}
+	if (len >= sizeof(buf)) {
+		mc->error = qtrue;
+		return;
+	}
+	MenuCache_Data(mc, buf, len);
+	buf[len] = 0;
+	if (!mc->error) {
+		*s = String_Alloc(buf);
+	}
+}
+
+/*
+=================
+MenuCache_Script
+=================
+*/
+static void MenuCache_Script(menuCache_t *mc, const char **s) {
+	MenuCache_String(mc, s);
+	if (!mc->writing && !mc->error) {
+		Script_Compile(*s);
+	}
+}
+
+/*
+=================
+MenuCache_Shader
+=================
+*/
+static void MenuCache_Shader(menuCache_t *mc, const char **name, qhandle_t *handle) {
+	MenuCache_String(mc, name);
+	if (!mc->writing && *name) {
+		*handle = DC->registerShaderNoMip(*name);
+	}
+}
+
+/*
+=================
+MenuCache_Window
+=================
+*/
+static void MenuCache_Window(menuCache_t *mc, windowDef_t *w) {
+	MenuCache_String(mc, &w->name);
+	MenuCache_String(mc, &w->group);
+	MenuCache_String(mc, &w->cinematicName);
+	if (!mc->writing) {
+		w->background = 0;
+	}
+	MenuCache_Shader(mc, &w->backgroundName, &w->background);
+}
+
+/*
+=================
+MenuCache_Alloc
+
+Transfers whether *p is set, allocating it when reading
+=================
+*/
+static qboolean MenuCache_Alloc(menuCache_t *mc, void **p, int size) {
+	int present;
+
+	present = (*p != NULL);
+	MenuCache_Data(mc, &present, sizeof(present));
+	if (mc->error || !present) {
+		if (!mc->writing) {
+			*p = NULL;
+		}
+		return qfalse;
+	}
+	if (!mc->writing) {
+		*p = UI_Alloc(size);
+		if (!*p) {
+			mc->error = qtrue;
+			return qfalse;
+		}
+	}
+	MenuCache_Data(mc, *p, size);
+	return !mc->error;
+}
+
+/*
+=================
+MenuCache_Multi
+=================
+*/
+static void MenuCache_Multi(menuCache_t *mc, multiDef_t *multiPtr) {
+	int i;
+
+	if (multiPtr->count < 0 || multiPtr->count > MAX_MULTI_CVARS) {
+		mc->error = qtrue;
+		return;
+	}
+	for (i = 0; i < MAX_MULTI_CVARS; i++) {
+		if (i < multiPtr->count) {
+			MenuCache_String(mc, &multiPtr->cvarList[i]);
+			MenuCache_String(mc, &multiPtr->cvarStr[i]);
+		} else if (!mc->writing) {
+			multiPtr->cvarList[i] = NULL;
+			multiPtr->cvarStr[i] = NULL;
+		}
+	}
+}
+
+/*
+=================
+MenuCache_TypeData
+
+Same types as Item_ValidateTypeData
+=================
+*/
+static void MenuCache_TypeData(menuCache_t *mc, itemDef_t *item) {
+	int size;
+
+	if (item->type == ITEM_TYPE_LISTBOX) {
+		size = sizeof(listBoxDef_t);
+	} else if (item->type == ITEM_TYPE_EDITFIELD || item->type == ITEM_TYPE_NUMERICFIELD || item->type == ITEM_TYPE_YESNO || item->type == ITEM_TYPE_BIND || item->type == ITEM_TYPE_SLIDER || item->type == ITEM_TYPE_TEXT) {
+		size = sizeof(editFieldDef_t);
+	} else if (item->type == ITEM_TYPE_MULTI) {
+		size = sizeof(multiDef_t);
+	} else if (item->type == ITEM_TYPE_MODEL) {
+		size = sizeof(modelDef_t);
+	} else {
+		// the type was changed after the data was allocated
+		if (mc->writing && item->typeData) {
+			mc->error = qtrue;
+		}
+		if (!mc->writing) {
+			item->typeData = NULL;
+		}
+		return;
+	}
+
+	if (!MenuCache_Alloc(mc, &item->typeData, size)) {
+		return;
+	}
+
+	if (item->type == ITEM_TYPE_LISTBOX) {
+		MenuCache_Script(mc, &((listBoxDef_t *)item->typeData)->doubleClick);
+	} else if (item->type == ITEM_TYPE_MULTI) {
+		MenuCache_Multi(mc, (multiDef_t *)item->typeData);
+	} else if (item->type == ITEM_TYPE_MODEL && !mc->writing) {
+		((modelDef_t *)item->typeData)->frameTime = DC->realTime;
+	}
+}
+
+/*
+=================
+MenuCache_Item
+=================
+*/
+static void MenuCache_Item(menuCache_t *mc, itemDef_t *item, menuDef_t *menu) {
+	MenuCache_Data(mc, item, sizeof(itemDef_t));
+	if (mc->error) {
+		return;
+	}
+
+	MenuCache_Window(mc, &item->window);
+	MenuCache_String(mc, &item->text);
+	MenuCache_Script(mc, &item->mouseEnterText);
+	MenuCache_Script(mc, &item->mouseExitText);
+	MenuCache_Script(mc, &item->mouseEnter);
+	MenuCache_Script(mc, &item->mouseExit);
+	MenuCache_Script(mc, &item->action);
+	MenuCache_Script(mc, &item->onFocus);
+	MenuCache_Script(mc, &item->leaveFocus);
+	MenuCache_Script(mc, &item->transitionEnd);
+	MenuCache_String(mc, &item->cvar);
+	MenuCache_String(mc, &item->cvarTest);
+	MenuCache_String(mc, &item->enableCvar);
+
+	MenuCache_String(mc, &item->assetModel);
+	MenuCache_String(mc, &item->assetShader);
+	MenuCache_String(mc, &item->focusSoundName);
+	if (!mc->writing) {
+		item->parent = menu;
+		item->cvarWatch = 0;
+		memset(&item->paint, 0, sizeof(item->paint));
+		item->asset = 0;
+		if (item->assetModel) {
+			item->asset = DC->registerModel(item->assetModel);
+		} else if (item->assetShader) {
+			item->asset = DC->registerShaderNoMip(item->assetShader);
+		}
+		item->focusSound = 0;
+		if (item->focusSoundName) {
+			item->focusSound = DC->registerSound(item->focusSoundName, qfalse);
+		}
+	}
+
+	MenuCache_TypeData(mc, item);
+	if (MenuCache_Alloc(mc, &item->multiData, sizeof(multiDef_t))) {
+		MenuCache_Multi(mc, (multiDef_t *)item->multiData);
+	}
+	MenuCache_Alloc(mc, &item->comboData, sizeof(comboDef_t));
+}
+
+/*
+=================
+MenuCache_Menu
+=================
+*/
+static void MenuCache_Menu(menuCache_t *mc, menuDef_t *menu) {
+	int i;
+
+	MenuCache_Data(mc, menu, sizeof(menuDef_t));
+	if (mc->error) {
+		return;
+	}
+	if (menu->itemCount < 0 || menu->itemCount > MAX_MENUITEMS) {
+		mc->error = qtrue;
+		return;
+	}
+
+	MenuCache_Window(mc, &menu->window);
+	MenuCache_String(mc, &menu->font);
+	MenuCache_Script(mc, &menu->onOpen);
+	MenuCache_Script(mc, &menu->onClose);
+	MenuCache_Script(mc, &menu->onESC);
+	MenuCache_Script(mc, &menu->opentransitionEnd);
+	MenuCache_Script(mc, &menu->esctransitionEnd);
+	MenuCache_String(mc, &menu->soundName);
+
+	for (i = 0; i < MAX_MENUITEMS; i++) {
+		if (i >= menu->itemCount) {
+			if (!mc->writing) {
+				menu->items[i] = NULL;
+			}
+			continue;
+		}
+		if (!mc->writing) {
+			menu->items[i] = UI_Alloc(sizeof(itemDef_t));
+			if (!menu->items[i]) {
+				mc->error = qtrue;
+			}
+		}
+		if (mc->error) {
+			return;
+		}
+		MenuCache_Item(mc, menu->items[i], menu);
+	}
+
+	// same as MenuParse_font
+	if (!mc->writing && !mc->error && menu->font && !DC->Assets.fontRegistered) {
+		DC->registerFont(menu->font, 48, &DC->Assets.textFont);
+		DC->Assets.fontRegistered = qtrue;
+	}
+}
+
+/*
+=================
+MenuCache_HeaderMatches
+=================
+*/
+static qboolean MenuCache_HeaderMatches(menuCacheHeader_t *header) {
+	menuCacheHeader_t current;
+	int i;
+
+	MenuCache_SetHeader(&current);
+	for (i = 0; i < sizeof(current.structSizes) / sizeof(current.structSizes[0]); i++) {
+		if (header->structSizes[i] != current.structSizes[i]) {
+			return qfalse;
+		}
+	}
+	return header->ident == current.ident && header->version == current.version
+		&& header->fadeAmount == current.fadeAmount && header->fadeClamp == current.fadeClamp
+		&& header->fadeCycle == current.fadeCycle;
+}
+
+/*
+=================
+Menu_LoadCache
+
+Adds the menus of menuFile from its cache file, returns qfalse if
+there is none or it is out of date
+=================
+*/
+qboolean Menu_LoadCache(const char *menuFile) {
+	menuCacheHeader_t header;
+	menuCacheSource_t cached, src;
+	menuCache_t mc;
+	int i, trailer;
+	int memMark, strMark;
+	qboolean memFull;
+
+	memset(&mc, 0, sizeof(mc));
+	mc.remaining = trap_FS_FOpenFile(va("menucache/%s.bin", menuFile), &mc.f, FS_READ);
+	if (!mc.f) {
+		return qfalse;
+	}
+
+	MenuCache_Data(&mc, &header, sizeof(header));
+	if (mc.error || !MenuCache_HeaderMatches(&header)
+		|| header.numSources < 1 || header.numSources > MAX_MENUCACHE_SOURCES
+		|| header.numMenus < 0 || menuCount + header.numMenus > MAX_MENUS) {
+		trap_FS_FCloseFile(mc.f);
+		return qfalse;
+	}
+
+	// any change to the sources means the file has to be parsed again
+	for (i = 0; i < header.numSources && !mc.error; i++) {
+		MenuCache_Data(&mc, &cached, sizeof(cached));
+		src = cached;
+		src.name[sizeof(src.name) - 1] = 0;
+		if (!mc.error && (!MenuCache_HashSource(&src) || src.length != cached.length || src.hash != cached.hash)) {
+			mc.error = qtrue;
+		}
+	}
+
+	memMark = allocPoint;
+	memFull = outOfMemory;
+	strMark = strPoolIndex;
+
+	for (i = 0; i < header.numMenus && !mc.error; i++) {
+		MenuCache_Menu(&mc, &Menus[menuCount + i]);
+	}
+
+	trailer = 0;
+	MenuCache_Data(&mc, &trailer, sizeof(trailer));
+	trap_FS_FCloseFile(mc.f);
+	if (mc.error || trailer != MENUCACHE_IDENT) {
+		// the file gets parsed now, give back what the partial menus took
+		Script_ReleasePrograms(&memoryPool[memMark]);
+		String_Release(strMark);
+		allocPoint = memMark;
+		outOfMemory = memFull;
+		return qfalse;
+	}
+
+	// the item rects depend on the video mode, which may have changed
+	for (i = 0; i < header.numMenus; i++) {
+		Menu_UpdatePosition(&Menus[menuCount + i]);
+	}
+
+	menuCount += header.numMenus;
+	return qtrue;
+}
+
+/*
+=================
+Menu_SaveCache
+
+Writes the menus from firstMenu on, which were just parsed from menuFile
+=================
+*/
+void Menu_SaveCache(const char *menuFile, int firstMenu) {
+	menuCacheSource_t sources[MAX_MENUCACHE_SOURCES];
+	menuCacheHeader_t header;
+	menuCache_t mc;
+	int i, numSources, trailer;
+
+	if (firstMenu < 0 || firstMenu > menuCount) {
+		return;
+	}
+
+	memset(sources, 0, sizeof(sources));
+	Q_strncpyz(sources[0].name, menuFile, sizeof(sources[0].name));
+	numSources = 1;
+	for (i = 0; i < numSources; i++) {
+		if (!MenuCache_HashSource(&sources[i])) {
+			return;
+		}
+		// a dependency that isn't tracked could serve a stale cache
+		if (!MenuCache_AddIncludes(sources, &numSources)) {
+			return;
+		}
+	}
+
+	memset(&mc, 0, sizeof(mc));
+	mc.writing = qtrue;
+	trap_FS_FOpenFile(va("menucache/%s.bin", menuFile), &mc.f, FS_WRITE);
+	if (!mc.f) {
+		return;
+	}
+
+	MenuCache_SetHeader(&header);
+	header.numSources = numSources;
+	header.numMenus = menuCount - firstMenu;
+	MenuCache_Data(&mc, &header, sizeof(header));
+	MenuCache_Data(&mc, sources, numSources * sizeof(sources[0]));
+
+	for (i = firstMenu; i < menuCount && !mc.error; i++) {
+		MenuCache_Menu(&mc, &Menus[i]);
+	}
+
+	// without the trailer the file is never used
+	if (!mc.error) {
+		trailer = MENUCACHE_IDENT;
+		MenuCache_Data(&mc, &trailer, sizeof(trailer));
+	}
+	trap_FS_FCloseFile(mc.f);
+}
+
+#endif
+
 int Menu_Count(void) {
 	return menuCount;
 }
@@ -79,10 +79,19 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #ifdef CGAME
 #define STRING_POOL_SIZE 128*1024
+#define STRING_POOL_MAX (512*1024)
+#define STRING_POOL_CVAR "cg_stringPoolSize"
+#define STRING_HASH_SIZE 4096
+#define PAINT_CACHE_CMDS 8192
+#define PAINT_CACHE_CVAR "cg_paintCache"
 #else
 #define STRING_POOL_SIZE 384*1024
+#define STRING_POOL_MAX (2*1024*1024)
+#define STRING_POOL_CVAR "ui_stringPoolSize"
+#define STRING_HASH_SIZE 16384
+#define PAINT_CACHE_CMDS 16384
+#define PAINT_CACHE_CVAR "ui_paintCache"
 #endif
-#define MAX_STRING_HANDLES 4096
 
 #define MAX_SCRIPT_ARGS 12
 #define MAX_EDITFIELD 256
@@ -161,6 +170,7 @@ typedef struct {
   vec4_t borderColor;             // border color
   vec4_t outlineColor;            // border color
   qhandle_t background;           // background asset  
+  const char *backgroundName;     // what background was registered from
 } windowDef_t;
 
 typedef windowDef_t Window;
@@ -264,6 +274,18 @@ typedef struct comboDef_s {
 #define CVAR_SHOW			0x00000004
 #define CVAR_HIDE			0x00000008
 
+#define MAX_PAINT_WATCHES 2
+
+// the draw commands an item issued the last time it was painted, see Item_Paint
+typedef struct {
+	unsigned key;                  // hash of the inputs the commands were recorded with
+	int first;                     // first command in the paint cache
+	int count;
+	int generation;                // paint cache generation the commands are from, 0 for none
+	int state;                     // 0 if not looked up, 1 if cacheable, -1 if it has to be painted every frame
+	int watches[MAX_PAINT_WATCHES];  // 1 + watch slots of the cvars the item reads, 0 for none
+} paintCache_t;
+
 typedef struct itemDef_s {
   Window window;                 // common positional, border, style, layout info
   Rectangle textRect;            // rectangle the text ( if any ) consumes     
@@ -277,6 +299,8 @@ typedef struct itemDef_s {
   const char *text;              // display text
   void *parent;                  // menu owner
   qhandle_t asset;               // handle to asset
+  const char *assetModel;        // what asset was registered from, only one is set
+  const char *assetShader;       //
   const char *mouseEnterText;    // mouse enter script
   const char *mouseExitText;     // mouse exit script
   const char *mouseEnter;        // mouse enter script
@@ -291,7 +315,11 @@ typedef struct itemDef_s {
   const char *cvarTest;          // associated cvar for enable actions
 	const char *enableCvar;			   // enable, disable, show, or hide based on value, this can contain a list
 	int cvarFlags;								 //	what type of action to take on cvarenables
+	int cvarWatch;								 // 1 + watched cvar slot of cvarTest, 0 if not looked up, -1 if none left
+	int cvarTestCount;						 // modificationCount of cvarTest that cvarTestMatch is for
+	qboolean cvarTestMatch;				 // cvarTest matched a value of enableCvar
   sfxHandle_t focusSound;
+  const char *focusSoundName;
 	int numColors;								 // number of color ranges
 	colorRangeDef_t colorRanges[MAX_COLOR_RANGES];
 	float special;								 // used for feeder id's etc.. diff per type
@@ -311,6 +339,7 @@ typedef struct itemDef_s {
  float scralignfactor;          // leilei - factor of adjustment
  int viewsizemin;             	// leilei - hide this if viewsize 
  int viewsizemax;             	// leilei - hide this if viewsize 
+	paintCache_t paint;						 // recorded draw commands
 } itemDef_t;
 
 typedef struct {
@@ -431,6 +460,7 @@ typedef struct {
   void (*ownerDrawItem) (float x, float y, float w, float h, float text_x, float text_y, int ownerDraw, int ownerDrawFlags, int align, float special, float scale, vec4_t color, qhandle_t shader, int textStyle);
 	float (*getValue) (int ownerDraw);
 	qboolean (*ownerDrawVisible) (int flags);
+	qboolean (*ownerDrawDeps) (int ownerDraw, int *key, const char **cvar);
   void (*runScript)(char **p);
   void (*getTeamColor)(vec4_t *color);
   void (*getCVarString)(const char *cvar, char *buffer, int bufsize);
@@ -483,6 +513,7 @@ typedef struct {
 const char *String_Alloc(const char *p);
 void String_Init( void );
 void String_Report( void );
+void String_Stats( void );
 void Init_Display(displayContextDef_t *dc);
 void Display_ExpandMacros(char * buff);
 void Menu_Init(menuDef_t *menu);
@@ -531,6 +562,16 @@ void Menus_CloseAll( void );
 void Menu_Paint(menuDef_t *menu, qboolean forcePaint);
 void Menu_SetFeederSelection(menuDef_t *menu, int feeder, int index, const char *name);
 void Display_CacheAll( void );
+void Display_UpdateCvarWatches( void );
+
+// the paint cache records the 2D drawing of each item, the module's
+// trap_R_SetColor and trap_R_DrawStretchPic are wrapped to feed it
+extern qboolean paintRecording;
+void Paint_TrackColor( const float *rgba );
+void Paint_RecordStretchPic( float x, float y, float w, float h, float s1, float t1, float s2, float t2, qhandle_t hShader );
+void Paint_Stats( void );
+qboolean Menu_LoadCache( const char *menuFile );
+void Menu_SaveCache( const char *menuFile, int firstMenu );
 
 void *UI_Alloc( int size );
 void UI_InitMemory( void );
@@ -547,6 +588,13 @@ int			trap_PC_LoadSource( const char *filename );
 int			trap_PC_FreeSource( int handle );
 int			trap_PC_ReadToken( int handle, pc_token_t *pc_token );
 int			trap_PC_SourceFileAndLine( int handle, char *filename, int *line );
+void		trap_Cvar_Register( vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags );
+void		trap_Cvar_Update( vmCvar_t *vmCvar );
+void		trap_Cvar_VariableStringBuffer( const char *var_name, char *buffer, int bufsize );
+int			trap_FS_FOpenFile( const char *qpath, fileHandle_t *f, fsMode_t mode );
+void		trap_FS_Read( void *buffer, int len, fileHandle_t f );
+void		trap_FS_Write( const void *buffer, int len, fileHandle_t f );
+void		trap_FS_FCloseFile( fileHandle_t f );
 
 void Item_Text_AutoWrapped_Paint( itemDef_t *item );
 
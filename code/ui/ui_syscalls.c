@@ -28,6 +28,10 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #error "Do not use in VM build"
 #endif
 
+// the paint cache wrappers from ui_local.h
+#undef trap_R_SetColor
+#undef trap_R_DrawStretchPic
+
 
 // rfactory change
 static long (QDECL *syscall)( long arg, ... ) = (long (QDECL *)( long, ...))-1;